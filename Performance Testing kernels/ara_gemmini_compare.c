@@ -11,23 +11,9 @@
 #endif
 
 #include "include/gemmini_testutils.h"
-
-// ============================================================================
-// Performance Measurement Utilities
-// ============================================================================
-
-// Inline assembly to read CSRs
-static inline uint64_t read_csr_mcycle() {
-    uint64_t result;
-    asm volatile("csrr %0, mcycle" : "=r"(result));
-    return result;
-}
-
-static inline uint64_t read_csr_minstret() {
-    uint64_t result;
-    asm volatile("csrr %0, minstret" : "=r"(result));
-    return result;
-}
+#include "hpm_utils.h"
+#include "bench_report.h"
+#include "bench_kernels.h"
 
 // ============================================================================
 // Static Test Data (no malloc needed)
@@ -47,69 +33,6 @@ static int32_t scalar_A[TEST_DIM * TEST_DIM] __attribute__((aligned(64)));
 static int32_t scalar_B[TEST_DIM * TEST_DIM] __attribute__((aligned(64)));
 static int32_t scalar_C[TEST_DIM * TEST_DIM] __attribute__((aligned(64)));
 
-// ============================================================================
-// Matrix Initialization
-// ============================================================================
-
-static void init_matrix_int8(elem_t mat[DIM][DIM], uint32_t seed) {
-    for (size_t i = 0; i < DIM; i++) {
-        for (size_t j = 0; j < DIM; j++) {
-            mat[i][j] = ((seed + i * DIM + j) % 16) - 8;  // Range: -8 to 7
-        }
-    }
-}
-
-static void init_matrix_int32(int32_t* mat, size_t size, uint32_t seed) {
-    for (size_t i = 0; i < size; i++) {
-        mat[i] = ((seed + i) % 64) - 32;  // Range: -32 to 31
-    }
-}
-
-static void zero_matrix_int8(elem_t mat[DIM][DIM]) {
-    for (size_t i = 0; i < DIM; i++) {
-        for (size_t j = 0; j < DIM; j++) {
-            mat[i][j] = 0;
-        }
-    }
-}
-
-static void zero_matrix_int32(int32_t* mat, size_t size) {
-    for (size_t i = 0; i < size; i++) {
-        mat[i] = 0;
-    }
-}
-
-// ============================================================================
-// Scalar Matrix Multiply (Reference)
-// ============================================================================
-
-static void scalar_matmul_int32(int32_t* A, int32_t* B, int32_t* C, size_t N) {
-    for (size_t i = 0; i < N; i++) {
-        for (size_t j = 0; j < N; j++) {
-            int64_t sum = 0;
-            for (size_t k = 0; k < N; k++) {
-                sum += (int64_t)A[i * N + k] * (int64_t)B[k * N + j];
-            }
-            C[i * N + j] = (int32_t)sum;
-        }
-    }
-}
-
-static void scalar_matmul_int8(elem_t A[DIM][DIM], elem_t B[DIM][DIM], elem_t C[DIM][DIM]) {
-    for (size_t i = 0; i < DIM; i++) {
-        for (size_t j = 0; j < DIM; j++) {
-            int32_t sum = 0;
-            for (size_t k = 0; k < DIM; k++) {
-                sum += (int32_t)A[i][k] * (int32_t)B[k][j];
-            }
-            // Saturate to int8 range
-            if (sum > 127) sum = 127;
-            if (sum < -128) sum = -128;
-            C[i][j] = (elem_t)sum;
-        }
-    }
-}
-
 // ============================================================================
 // Test 1: Scalar CPU Matrix Multiply Performance
 // ============================================================================
@@ -128,28 +51,31 @@ int test_scalar_matmul() {
     
     // Measure scalar matmul performance
     printf("Computing matrix multiply on scalar Rocket core...\n");
-    uint64_t start_cycles = read_csr_mcycle();
-    uint64_t start_instrs = read_csr_minstret();
+    hpm_region_t perf;
+    hpm_start(&perf, &HPM_GROUP);
     
     scalar_matmul_int32(scalar_A, scalar_B, scalar_C, TEST_DIM);
     
-    uint64_t end_cycles = read_csr_mcycle();
-    uint64_t end_instrs = read_csr_minstret();
+    hpm_stop(&perf);
     
-    uint64_t cycles = end_cycles - start_cycles;
-    uint64_t instrs = end_instrs - start_instrs;
+    uint64_t cycles = perf.delta.cycles;
     
     printf("[PERF] Scalar Matmul %dx%d INT32\n", TEST_DIM, TEST_DIM);
-    printf("  Cycles: %llu\n", (unsigned long long)cycles);
-    printf("  Instructions: %llu\n", (unsigned long long)instrs);
+    hpm_print_region(&perf);
+    bench_emit_region(BENCH_DESC("matmul", "scalar", "int32", TEST_DIM, TEST_DIM, TEST_DIM),
+                      &perf, 0);
     printf("  Ops (2*N^3): %llu\n", (unsigned long long)(2ULL * TEST_DIM * TEST_DIM * TEST_DIM));
     // Ops/cycle calculated: ops * 1000 / cycles for integer display
     uint64_t ops_x1000 = (2ULL * TEST_DIM * TEST_DIM * TEST_DIM * 1000) / cycles;
     printf("  Ops/cycle x1000: %llu\n", (unsigned long long)ops_x1000);
     printf("\n");
     
-    printf("Scalar matmul test PASSED\n");
-    return 0;
+    // No independent reference at this size: check every row sum instead
+    int errors = verify_matmul_rowsums_int32(scalar_A, scalar_B, scalar_C,
+                                             TEST_DIM, TEST_DIM, TEST_DIM);
+    int failed = verify_report(errors);
+    printf("Scalar matmul test %s\n", failed ? "FAILED" : "PASSED");
+    return failed;
 }
 
 // ============================================================================
@@ -182,74 +108,44 @@ int test_gemmini_matmul() {
     // Configure Gemmini
     printf("Computing on Gemmini systolic array...\n");
     
-    // Scratchpad addresses
-    size_t A_sp_addr = 0;
-    size_t B_sp_addr = DIM;
-    size_t C_sp_addr = 2 * DIM;
-    
-    // Measure Gemmini performance
-    uint64_t start_cycles = read_csr_mcycle();
-    uint64_t start_instrs = read_csr_minstret();
-    
-    // Configure load/store
-    gemmini_config_ld(DIM * sizeof(elem_t));
-    gemmini_config_st(DIM * sizeof(elem_t));
-    
-    // Move matrices to scratchpad
-    gemmini_mvin(gemmini_A, A_sp_addr);
-    gemmini_mvin(gemmini_B, B_sp_addr);
-    
-    // Configure for output-stationary mode
-    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
+    // Measure Gemmini performance: config, mvin A/B, compute, mvout, fence
+    hpm_region_t perf;
+    hpm_start(&perf, &HPM_GROUP);
     
-    // Preload zeros (bias) and compute
-    gemmini_preload_zeros(C_sp_addr);
-    gemmini_compute_preloaded(A_sp_addr, B_sp_addr);
+    gemmini_matmul_tile(gemmini_A, gemmini_B, gemmini_C);
     
-    // Move result back to main memory
-    gemmini_mvout(gemmini_C, C_sp_addr);
+    hpm_stop(&perf);
     
-    // Wait for completion
-    gemmini_fence();
-    
-    uint64_t end_cycles = read_csr_mcycle();
-    uint64_t end_instrs = read_csr_minstret();
-    
-    uint64_t cycles = end_cycles - start_cycles;
-    uint64_t instrs = end_instrs - start_instrs;
+    uint64_t cycles = perf.delta.cycles;
     
     printf("[PERF] Gemmini Matmul %dx%d INT8\n", DIM, DIM);
-    printf("  Cycles: %llu\n", (unsigned long long)cycles);
-    printf("  Instructions: %llu\n", (unsigned long long)instrs);
+    hpm_print_region(&perf);
+    bench_emit_region(BENCH_DESC("matmul", "gemmini", "int8", DIM, DIM, DIM), &perf, 0);
     printf("  Ops (2*N^3): %llu\n", (unsigned long long)(2ULL * DIM * DIM * DIM));
     // Ops/cycle calculated: ops * 1000 / cycles for integer display
     uint64_t gemmini_ops_x1000 = (2ULL * DIM * DIM * DIM * 1000) / cycles;
     printf("  Ops/cycle x1000: %llu\n", (unsigned long long)gemmini_ops_x1000);
     printf("\n");
     
+    // Same tile again with a fence after every phase, so configuration cost
+    // is visible instead of hidden in the total above
+    gemmini_tile_phases_t ph;
+    gemmini_matmul_tile_phased(gemmini_A, gemmini_B, gemmini_C, &ph);
+    printf("Phase breakdown (each phase fenced):\n");
+    printf("  Setup (config):    %llu\n", (unsigned long long)ph.setup);
+    printf("  mvin A + B:        %llu\n", (unsigned long long)ph.mvin);
+    printf("  preload + compute: %llu\n", (unsigned long long)ph.compute);
+    printf("  mvout C:           %llu\n", (unsigned long long)ph.mvout);
+    printf("  Idle fence:        %llu (included in each phase)\n", (unsigned long long)ph.fence);
+    printf("\n");
+    
     // Verify result
     printf("Verifying results...\n");
-    int errors = 0;
-    for (size_t i = 0; i < DIM && errors < 5; i++) {
-        for (size_t j = 0; j < DIM && errors < 5; j++) {
-            // Allow small tolerance due to potential saturation differences
-            int diff = (int)gemmini_C[i][j] - (int)gemmini_ref[i][j];
-            if (diff < -1 || diff > 1) {
-                printf("  Mismatch at [%zu][%zu]: got %d, expected %d\n",
-                       i, j, (int)gemmini_C[i][j], (int)gemmini_ref[i][j]);
-                errors++;
-            }
-        }
-    }
-    
-    if (errors == 0) {
-        printf("Gemmini results match reference\n");
-    } else {
-        printf("WARNING: Some mismatches found (may be due to saturation)\n");
-    }
-    
-    printf("Gemmini matmul test PASSED\n");
-    return 0;
+    // The reference saturates exactly like Gemmini's mvout, so no tolerance
+    int errors = verify_int8(&gemmini_C[0][0], &gemmini_ref[0][0], DIM * DIM, DIM, 0);
+    int failed = verify_report(errors);
+    printf("Gemmini matmul test %s\n", failed ? "FAILED" : "PASSED");
+    return failed;
 }
 
 // ============================================================================
@@ -275,24 +171,20 @@ int test_performance_comparison() {
     uint64_t scalar_end = read_csr_mcycle();
     uint64_t scalar_cycles = scalar_end - scalar_start;
     
+    // Tuned scalar baseline (cache-blocked, 4x4 register tile) on the same data
+    uint64_t tuned_start = read_csr_mcycle();
+    scalar_matmul_int32_tiled(scalar_A, scalar_B, scalar_C, TEST_DIM, TEST_DIM, TEST_DIM);
+    uint64_t tuned_end = read_csr_mcycle();
+    uint64_t tuned_cycles = tuned_end - tuned_start;
+    
     // Gemmini INT8 matmul
     gemmini_flush(0);
     init_matrix_int8(gemmini_A, 0x3333);
     init_matrix_int8(gemmini_B, 0x4444);
     zero_matrix_int8(gemmini_C);
     
-    size_t A_sp = 0, B_sp = DIM, C_sp = 2*DIM;
-    
     uint64_t gemmini_start = read_csr_mcycle();
-    gemmini_config_ld(DIM * sizeof(elem_t));
-    gemmini_config_st(DIM * sizeof(elem_t));
-    gemmini_mvin(gemmini_A, A_sp);
-    gemmini_mvin(gemmini_B, B_sp);
-    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
-    gemmini_preload_zeros(C_sp);
-    gemmini_compute_preloaded(A_sp, B_sp);
-    gemmini_mvout(gemmini_C, C_sp);
-    gemmini_fence();
+    gemmini_matmul_tile(gemmini_A, gemmini_B, gemmini_C);
     uint64_t gemmini_end = read_csr_mcycle();
     uint64_t gemmini_cycles = gemmini_end - gemmini_start;
     
@@ -305,14 +197,30 @@ int test_performance_comparison() {
     printf("| Scalar CPU  | %3dx%3d     | INT32     | %10llu |\n",
            TEST_DIM, TEST_DIM, 
            (unsigned long long)scalar_cycles);
+    printf("| Scalar tuned| %3dx%3d     | INT32     | %10llu |\n",
+           TEST_DIM, TEST_DIM,
+           (unsigned long long)tuned_cycles);
     printf("| Gemmini     | %3dx%3d     | INT8      | %10llu |\n",
            DIM, DIM,
            (unsigned long long)gemmini_cycles);
     printf("\n");
     
-    // Calculate speedup as integer ratio
-    uint64_t speedup = scalar_cycles / gemmini_cycles;
-    printf("Gemmini Speedup: %llux faster than scalar CPU\n", (unsigned long long)speedup);
+    bench_emit_cycles(BENCH_DESC("matmul", "scalar", "int32", TEST_DIM, TEST_DIM, TEST_DIM),
+                      scalar_cycles, scalar_cycles);
+    bench_emit_cycles(BENCH_DESC("matmul", "scalar-tuned", "int32", TEST_DIM, TEST_DIM, TEST_DIM),
+                      tuned_cycles, scalar_cycles);
+    bench_emit_cycles(BENCH_DESC("matmul", "gemmini", "int8", DIM, DIM, DIM),
+                      gemmini_cycles, scalar_cycles);
+    
+    // Speedup in fixed point with two decimals
+    uint64_t speedup_x100 = scalar_cycles * 100 / gemmini_cycles;
+    printf("Gemmini Speedup: %llu.%02llux faster than scalar CPU\n",
+           (unsigned long long)(speedup_x100 / 100),
+           (unsigned long long)(speedup_x100 % 100));
+    uint64_t tuned_x100 = tuned_cycles * 100 / gemmini_cycles;
+    printf("Gemmini Speedup: %llu.%02llux faster than tuned scalar CPU\n",
+           (unsigned long long)(tuned_x100 / 100),
+           (unsigned long long)(tuned_x100 % 100));
     printf("\n");
     
     return 0;
@@ -343,6 +251,7 @@ int main() {
     result |= test_scalar_matmul();
     result |= test_gemmini_matmul();
     result |= test_performance_comparison();
+    result = verify_exit_status(result);
     
     printf("\n");
     printf("######################################################################\n");
@@ -0,0 +1,85 @@
+// Benchmark case registry: a workload is a table entry, not a test function
+// Each case names its shape and hooks; bench_run_case() does the rest
+// (prepare, BENCH_RUN, [PERF] block, CSV/JSON record, verification).
+//
+//   static const bench_case_t cases[] = {
+//       { "Scalar SAXPY", { "saxpy", "scalar", "int32", 1, VEC_LEN, 1 },
+//         2 * VEC_LEN, saxpy_prepare, saxpy_reset_y, run_scalar_saxpy, NULL },
+//   };
+//   result |= bench_run_cases(cases, BENCH_NUM_CASES(cases), NULL);
+
+#ifndef BENCH_CASE_H
+#define BENCH_CASE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench_kernels.h"
+#include "bench_stats.h"
+#include "bench_report.h"
+
+// Cases per table that can serve as a speedup baseline
+#define BENCH_MAX_CASES 16
+
+typedef struct {
+    const char* title;      // [PERF] heading
+    bench_desc_t desc;      // Kernel/backend/dtype/shape for reports
+    uint64_t ops;           // Work per run, for the Ops line (0 = omit)
+    void (*prepare)(void);  // Once, untimed: operands and reference (may be NULL)
+    void (*setup)(void);    // Before every repetition, untimed (may be NULL)
+    void (*run)(void);      // The timed kernel
+    int (*verify)(void);    // Mismatch count after the last run (may be NULL)
+} bench_case_t;
+
+#define BENCH_NUM_CASES(cases) (sizeof(cases) / sizeof((cases)[0]))
+
+// Run one case; base_cycles is the median it is compared against in the
+// record (0 = none). Stats are left in *st. Returns 1 if verification failed.
+static inline int bench_run_case(const bench_case_t* c, bench_stats_t* st, uint64_t base_cycles) {
+    const bench_desc_t* d = &c->desc;
+
+    if (c->prepare) c->prepare();
+    BENCH_RUN(st, if (c->setup) c->setup(), c->run());
+
+    printf("[PERF] %s\n", c->title);
+    if (d->m == 1 && d->k == 1) {
+        printf("  Vector Length: %zu\n", d->n);
+    } else {
+        printf("  Matrix Size: %zux%zux%zu (%s)\n", d->m, d->n, d->k, d->dtype);
+    }
+    bench_print_stats(st);
+    bench_emit(d, st, base_cycles);
+    if (c->ops) printf("  Ops: %llu\n", (unsigned long long)c->ops);
+
+    int failed = 0;
+    if (c->verify) failed = verify_report(c->verify());
+    printf("\n");
+    return failed;
+}
+
+// Run a table of cases in order. When `stats` is non-NULL it receives one
+// bench_stats_t per case. Records of later cases carry the speedup over the
+// first case with the same kernel name.
+static inline int bench_run_cases(const bench_case_t* cases, size_t num_cases, bench_stats_t* stats) {
+    int result = 0;
+    uint64_t base[BENCH_MAX_CASES];
+    bench_stats_t st;
+
+    for (size_t i = 0; i < num_cases; i++) {
+        uint64_t base_cycles = 0;
+        for (size_t j = 0; j < i && j < BENCH_MAX_CASES; j++) {
+            if (strcmp(cases[j].desc.kernel, cases[i].desc.kernel) == 0) {
+                base_cycles = base[j];
+                break;
+            }
+        }
+        bench_stats_t* out = stats ? &stats[i] : &st;
+        result |= bench_run_case(&cases[i], out, base_cycles);
+        if (i < BENCH_MAX_CASES) base[i] = out->median;
+    }
+    return result;
+}
+
+#endif // BENCH_CASE_H
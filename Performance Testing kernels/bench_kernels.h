@@ -0,0 +1,2836 @@
+// Shared benchmark kernels: timers, data generators, scalar references,
+// Ara (RVV) and Gemmini backends, and result verification
+// Every testbench includes this instead of carrying its own copies, so a
+// change to a reference or backend kernel shows up in every comparison.
+// Requires -march=rv64gcv for the Ara kernels.
+
+#ifndef BENCH_KERNELS_H
+#define BENCH_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "include/gemmini_testutils.h"
+
+#ifndef CEIL_DIV
+#define CEIL_DIV(a, b) (((a) + (b) - 1) / (b))
+#endif
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+// ============================================================================
+// Performance Measurement Utilities
+// ============================================================================
+
+// Linux builds run in U-mode, where mcycle/minstret trap; they read the
+// unprivileged cycle/instret shadows instead (the kernel must expose them
+// through scounteren)
+static inline uint64_t read_csr_mcycle() {
+    uint64_t result;
+#ifdef BAREMETAL
+    asm volatile("csrr %0, mcycle" : "=r"(result));
+#else
+    asm volatile("rdcycle %0" : "=r"(result));
+#endif
+    return result;
+}
+
+static inline uint64_t read_csr_minstret() {
+    uint64_t result;
+#ifdef BAREMETAL
+    asm volatile("csrr %0, minstret" : "=r"(result));
+#else
+    asm volatile("rdinstret %0" : "=r"(result));
+#endif
+    return result;
+}
+
+static inline size_t read_csr_mhartid(void) {
+    size_t id;
+    asm volatile("csrr %0, mhartid" : "=r"(id));
+    return id;
+}
+
+// ============================================================================
+// RVV (RISC-V Vector) Intrinsics and Configuration
+// ============================================================================
+
+// Enable vector extension in MSTATUS
+// Under Linux the kernel owns mstatus and enables the vector unit for the
+// process itself, so this is a no-op there
+static inline void enable_vector_extension() {
+#ifdef BAREMETAL
+    // Set MSTATUS.VS = Initial (01) to enable vector instructions
+    // MSTATUS.VS is at bits [10:9]
+    uint64_t mstatus;
+    asm volatile("csrr %0, mstatus" : "=r"(mstatus));
+    mstatus |= (1UL << 9);  // Set VS to 01 (Initial)
+    asm volatile("csrw mstatus, %0" : : "r"(mstatus));
+#endif
+}
+
+// ============================================================================
+// Matrix/Vector Initialization
+// ============================================================================
+
+static inline void init_matrix_int8(elem_t mat[DIM][DIM], uint32_t seed) {
+    for (size_t i = 0; i < DIM; i++) {
+        for (size_t j = 0; j < DIM; j++) {
+            mat[i][j] = ((seed + i * DIM + j) % 16) - 8;
+        }
+    }
+}
+
+static inline void init_matrix_int32(int32_t* mat, size_t size, uint32_t seed) {
+    for (size_t i = 0; i < size; i++) {
+        mat[i] = ((seed + i) % 64) - 32;
+    }
+}
+
+static inline void init_vector_int32(int32_t* vec, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        vec[i] = ((seed + i) % 100) - 50;
+    }
+}
+
+// Row-major rows x cols INT8 matrix, same value pattern as init_matrix_int8
+static inline void init_matrix_int8_rect(elem_t* mat, size_t rows, size_t cols, uint32_t seed) {
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            mat[i * cols + j] = ((seed + i * cols + j) % 16) - 8;
+        }
+    }
+}
+
+static inline void zero_matrix_int8(elem_t mat[DIM][DIM]) {
+    for (size_t i = 0; i < DIM; i++) {
+        for (size_t j = 0; j < DIM; j++) {
+            mat[i][j] = 0;
+        }
+    }
+}
+
+static inline void zero_matrix_int32(int32_t* mat, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        mat[i] = 0;
+    }
+}
+
+// BF16 is stored as the upper half of an FP32 bit pattern. Narrowing
+// rounds to nearest even; NaN payloads are not preserved.
+typedef uint16_t bf16_t;
+
+static inline float bf16_to_fp32(bf16_t h) {
+    uint32_t u = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline bf16_t bf16_from_fp32(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    u += 0x7FFF + ((u >> 16) & 1);
+    return (bf16_t)(u >> 16);
+}
+
+// Multiples of 1/8 in [-6.25, 6.125]: exact in BF16, and products and
+// sums stay exact in FP32 for K up to several thousand, so summation
+// order does not change the reference
+static inline void init_vector_fp32(float* vec, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        vec[i] = (float)((int32_t)((seed + i) % 100) - 50) * 0.125f;
+    }
+}
+
+static inline void init_vector_bf16(bf16_t* vec, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        vec[i] = bf16_from_fp32((float)((int32_t)((seed + i) % 100) - 50) * 0.125f);
+    }
+}
+
+// ============================================================================
+// GEMM Shapes and Layouts
+// ============================================================================
+
+// Problem shape and operand layout for C = A * B with A MxK, B KxN, C MxN.
+// Leading dimensions are in elements (ldc in elements of whichever output
+// type a backend writes); 0 selects the packed value rounded up to a
+// multiple of `align` bytes per row. With trans_b, B is stored N x K (one row per output
+// column, as convolution weights usually are) and ldb is that row pitch.
+typedef struct {
+    size_t m, n, k;
+    size_t lda, ldb, ldc;
+    int trans_b;
+    size_t align;  // Row pitch alignment in bytes for derived lds (0 = none)
+} gemm_layout_t;
+
+// Filler for the padding between rows: large enough that a kernel which
+// reads padding produces a visibly wrong result
+#define GEMM_PAD_BYTE 0x5A
+
+static inline size_t gemm_round_ld(size_t ld, size_t elem_bytes, size_t align) {
+    if (align <= elem_bytes) return ld;
+    return CEIL_DIV(ld * elem_bytes, align) * align / elem_bytes;
+}
+
+// Fill in derived leading dimensions. Returns 0, or -1
+// if an explicit ld is shorter than its row.
+static inline int gemm_layout_resolve(gemm_layout_t* l) {
+    const size_t b_row = l->trans_b ? l->k : l->n;
+    if (l->lda == 0) l->lda = gemm_round_ld(l->k, sizeof(elem_t), l->align);
+    if (l->ldb == 0) l->ldb = gemm_round_ld(b_row, sizeof(elem_t), l->align);
+    if (l->ldc == 0) l->ldc = gemm_round_ld(l->n, sizeof(elem_t), l->align);
+    return (l->lda < l->k || l->ldb < b_row || l->ldc < l->n) ? -1 : 0;
+}
+
+// Storage in elements, padding included
+static inline size_t gemm_layout_a_elems(const gemm_layout_t* l) { return l->m * l->lda; }
+static inline size_t gemm_layout_b_elems(const gemm_layout_t* l) {
+    return (l->trans_b ? l->n : l->k) * l->ldb;
+}
+static inline size_t gemm_layout_c_elems(const gemm_layout_t* l) { return l->m * l->ldc; }
+
+// Element (k, j) of the logical KxN B, whatever its storage
+static inline elem_t gemm_layout_b_at(const gemm_layout_t* l, const elem_t* B, size_t k, size_t j) {
+    return l->trans_b ? B[j * l->ldb + k] : B[k * l->ldb + j];
+}
+
+// Build A and B for a resolved layout. Values depend only on the logical
+// index, with the init_matrix_int8_rect pattern, so every layout of a shape
+// has the same product; padding is GEMM_PAD_BYTE.
+static inline void gemm_layout_init(const gemm_layout_t* l, elem_t* A, elem_t* B,
+                                    uint32_t seed_a, uint32_t seed_b) {
+    memset(A, GEMM_PAD_BYTE, gemm_layout_a_elems(l) * sizeof(elem_t));
+    memset(B, GEMM_PAD_BYTE, gemm_layout_b_elems(l) * sizeof(elem_t));
+    for (size_t i = 0; i < l->m; i++) {
+        for (size_t k = 0; k < l->k; k++) {
+            A[i * l->lda + k] = ((seed_a + i * l->k + k) % 16) - 8;
+        }
+    }
+    for (size_t k = 0; k < l->k; k++) {
+        for (size_t j = 0; j < l->n; j++) {
+            elem_t v = ((seed_b + k * l->n + j) % 16) - 8;
+            if (l->trans_b) B[j * l->ldb + k] = v;
+            else B[k * l->ldb + j] = v;
+        }
+    }
+}
+
+// Copy B into packed row-major KxN for backends that cannot read it in place
+static inline void gemm_layout_pack_b(const gemm_layout_t* l, const elem_t* B, elem_t* packed) {
+    for (size_t k = 0; k < l->k; k++) {
+        for (size_t j = 0; j < l->n; j++) {
+            packed[k * l->n + j] = gemm_layout_b_at(l, B, k, j);
+        }
+    }
+}
+
+// ============================================================================
+// Scalar Operations
+// ============================================================================
+
+// Scalar SAXPY: y = a*x + y
+static inline void scalar_saxpy(int32_t a, int32_t* x, int32_t* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = a * x[i] + y[i];
+    }
+}
+
+// Scalar dot product with 64-bit accumulation
+static inline int64_t scalar_dot_int32(int32_t* x, int32_t* y, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (int64_t)x[i] * (int64_t)y[i];
+    }
+    return sum;
+}
+
+// Scalar matrix multiply
+static inline void scalar_matmul_int32(int32_t* A, int32_t* B, int32_t* C, size_t N) {
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            int64_t sum = 0;
+            for (size_t k = 0; k < N; k++) {
+                sum += (int64_t)A[i * N + k] * (int64_t)B[k * N + j];
+            }
+            C[i * N + j] = (int32_t)sum;
+        }
+    }
+}
+
+// Scalar FP32 SAXPY: y = a*x + y
+static inline void scalar_saxpy_fp32(float a, const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = a * x[i] + y[i];
+    }
+}
+
+// BF16 SAXPY computed in FP32, rounded back to BF16
+static inline void scalar_saxpy_bf16(float a, const bf16_t* x, bf16_t* y, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        y[i] = bf16_from_fp32(a * bf16_to_fp32(x[i]) + bf16_to_fp32(y[i]));
+    }
+}
+
+// Scalar FP32 matmul, MxK * KxN, summed in k order
+static inline void scalar_matmul_fp32(const float* A, const float* B, float* C,
+                                      size_t M, size_t N, size_t K) {
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < K; k++) {
+                sum += A[i * K + k] * B[k * N + j];
+            }
+            C[i * N + j] = sum;
+        }
+    }
+}
+
+// BF16 x BF16 -> FP32 matmul (FP32 accumulation)
+static inline void scalar_matmul_bf16(const bf16_t* A, const bf16_t* B, float* C,
+                                      size_t M, size_t N, size_t K) {
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < K; k++) {
+                sum += bf16_to_fp32(A[i * K + k]) * bf16_to_fp32(B[k * N + j]);
+            }
+            C[i * N + j] = sum;
+        }
+    }
+}
+
+// Requantize one INT32 sum exactly as Gemmini's mvout does: ACC_SCALE
+// (round to nearest even), optional ReLU, then saturate to elem_t
+static inline elem_t requant_acc(acc_t x, acc_scale_t scale, int act) {
+    acc_t y = ACC_SCALE(x, scale);
+    if (act == RELU && y < 0) y = 0;
+    if (y > elem_t_max) y = elem_t_max;
+    if (y < elem_t_min) y = elem_t_min;
+    return (elem_t)y;
+}
+
+// Bit-exact model of a Gemmini mvout with the identity scale and no
+// activation: what the saturating INT8 references below produce
+#define GEMMINI_SATURATE(sum) requant_acc((sum), ACC_SCALE_IDENTITY, NO_ACTIVATION)
+
+static inline void scalar_matmul_int8(elem_t A[DIM][DIM], elem_t B[DIM][DIM], elem_t C[DIM][DIM]) {
+    for (size_t i = 0; i < DIM; i++) {
+        for (size_t j = 0; j < DIM; j++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < DIM; k++) {
+                sum += (int32_t)A[i][k] * (int32_t)B[k][j];
+            }
+            C[i][j] = GEMMINI_SATURATE(sum);
+        }
+    }
+}
+
+// Scalar INT8 matmul for row-major MxK * KxN, saturating like the Gemmini path
+static inline void scalar_matmul_int8_rect(const elem_t* A, const elem_t* B, elem_t* C,
+                                           size_t M, size_t N, size_t K) {
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < K; k++) {
+                sum += (int32_t)A[i * K + k] * (int32_t)B[k * N + j];
+            }
+            C[i * N + j] = GEMMINI_SATURATE(sum);
+        }
+    }
+}
+
+// Scalar INT8 x INT8 -> INT32 matmul without saturation (widening reference)
+static inline void scalar_matmul_int8_wide(const elem_t* A, const elem_t* B, int32_t* C,
+                                           size_t M, size_t N, size_t K) {
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < K; k++) {
+                sum += (int32_t)A[i * K + k] * (int32_t)B[k * N + j];
+            }
+            C[i * N + j] = sum;
+        }
+    }
+}
+
+// Cache blocking for the tuned scalar GEMM, sized for a 16 KB Rocket L1 D$:
+// a BLOCK_K x BLOCK_N INT32 panel of B is 8 KB and stays resident while
+// BLOCK_M rows of A stream past it
+#ifndef SCALAR_BLOCK_M
+#define SCALAR_BLOCK_M 32
+#endif
+#ifndef SCALAR_BLOCK_N
+#define SCALAR_BLOCK_N 64
+#endif
+#ifndef SCALAR_BLOCK_K
+#define SCALAR_BLOCK_K 32
+#endif
+
+// Tuned scalar GEMM: C (MxN, INT32) = A (MxK) * B (KxN), row-major, for
+// element type in_t. Loops run k-block, n-block, m-block so the B panel is
+// reused from L1; inside a block a 4x4 register tile keeps 16 sums in
+// registers and reads B along rows (unit stride) instead of down columns.
+// Sums wrap in 32 bits, matching the naive kernels' truncated results.
+#define SCALAR_MATMUL_TILED(name, in_t)                                                  \
+static inline void name##_block(const in_t* A, const in_t* B, int32_t* C, size_t N,    \
+                                size_t K, size_t mb, size_t nb, size_t kb) {           \
+    size_t i = 0;                                                                      \
+    for (; i + 4 <= mb; i += 4) {                                                      \
+        const in_t* a0 = A + i * K;                                                    \
+        const in_t* a1 = a0 + K;                                                       \
+        const in_t* a2 = a1 + K;                                                       \
+        const in_t* a3 = a2 + K;                                                       \
+        size_t j = 0;                                                                  \
+        for (; j + 4 <= nb; j += 4) {                                                  \
+            uint32_t c00 = 0, c01 = 0, c02 = 0, c03 = 0;                               \
+            uint32_t c10 = 0, c11 = 0, c12 = 0, c13 = 0;                               \
+            uint32_t c20 = 0, c21 = 0, c22 = 0, c23 = 0;                               \
+            uint32_t c30 = 0, c31 = 0, c32 = 0, c33 = 0;                               \
+            const in_t* b = B + j;                                                     \
+            for (size_t k = 0; k < kb; k++, b += N) {                                  \
+                const uint32_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];             \
+                const uint32_t x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];         \
+                c00 += x0 * b0; c01 += x0 * b1; c02 += x0 * b2; c03 += x0 * b3;        \
+                c10 += x1 * b0; c11 += x1 * b1; c12 += x1 * b2; c13 += x1 * b3;        \
+                c20 += x2 * b0; c21 += x2 * b1; c22 += x2 * b2; c23 += x2 * b3;        \
+                c30 += x3 * b0; c31 += x3 * b1; c32 += x3 * b2; c33 += x3 * b3;        \
+            }                                                                          \
+            int32_t* c = C + i * N + j;                                                \
+            c[0] += c00; c[1] += c01; c[2] += c02; c[3] += c03; c += N;                \
+            c[0] += c10; c[1] += c11; c[2] += c12; c[3] += c13; c += N;                \
+            c[0] += c20; c[1] += c21; c[2] += c22; c[3] += c23; c += N;                \
+            c[0] += c30; c[1] += c31; c[2] += c32; c[3] += c33;                        \
+        }                                                                              \
+        for (; j < nb; j++) {                                                          \
+            uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;                                   \
+            for (size_t k = 0; k < kb; k++) {                                          \
+                const uint32_t bv = B[k * N + j];                                      \
+                s0 += (uint32_t)a0[k] * bv; s1 += (uint32_t)a1[k] * bv;                \
+                s2 += (uint32_t)a2[k] * bv; s3 += (uint32_t)a3[k] * bv;                \
+            }                                                                          \
+            C[i * N + j] += s0; C[(i + 1) * N + j] += s1;                              \
+            C[(i + 2) * N + j] += s2; C[(i + 3) * N + j] += s3;                        \
+        }                                                                              \
+    }                                                                                  \
+    for (; i < mb; i++) {                                                              \
+        for (size_t k = 0; k < kb; k++) {                                              \
+            const uint32_t av = A[i * K + k];                                          \
+            const in_t* b = B + k * N;                                                 \
+            int32_t* c = C + i * N;                                                    \
+            for (size_t j = 0; j < nb; j++) c[j] += av * (uint32_t)b[j];               \
+        }                                                                              \
+    }                                                                                  \
+}                                                                                      \
+                                                                                       \
+static inline void name(const in_t* A, const in_t* B, int32_t* C,                      \
+                        size_t M, size_t N, size_t K) {                                \
+    memset(C, 0, M * N * sizeof(int32_t));                                             \
+    for (size_t k0 = 0; k0 < K; k0 += SCALAR_BLOCK_K) {                                \
+        const size_t kb = MIN(SCALAR_BLOCK_K, K - k0);                                 \
+        for (size_t j0 = 0; j0 < N; j0 += SCALAR_BLOCK_N) {                            \
+            const size_t nb = MIN(SCALAR_BLOCK_N, N - j0);                             \
+            for (size_t i0 = 0; i0 < M; i0 += SCALAR_BLOCK_M) {                        \
+                const size_t mb = MIN(SCALAR_BLOCK_M, M - i0);                         \
+                name##_block(A + i0 * K + k0, B + k0 * N + j0, C + i0 * N + j0,        \
+                             N, K, mb, nb, kb);                                        \
+            }                                                                          \
+        }                                                                              \
+    }                                                                                  \
+}
+
+SCALAR_MATMUL_TILED(scalar_matmul_int32_tiled, int32_t)
+SCALAR_MATMUL_TILED(scalar_matmul_int8_wide_tiled, elem_t)
+
+// Widening (INT32) and saturating (INT8) references for any gemm_layout_t;
+// either output may be NULL, both use ldc
+static inline void scalar_matmul_int8_layout(const gemm_layout_t* l, const elem_t* A, const elem_t* B,
+                                             int32_t* C32, elem_t* C8) {
+    for (size_t i = 0; i < l->m; i++) {
+        for (size_t j = 0; j < l->n; j++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < l->k; k++) {
+                sum += (int32_t)A[i * l->lda + k] * (int32_t)gemm_layout_b_at(l, B, k, j);
+            }
+            if (C32) C32[i * l->ldc + j] = sum;
+            if (C8) C8[i * l->ldc + j] = GEMMINI_SATURATE(sum);
+        }
+    }
+}
+
+// Scalar GEMM epilogue, reference for ara_bias_relu_int32
+static inline void scalar_bias_relu_int32(int32_t* C, const int32_t* bias, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            int32_t v = C[i * cols + j] + bias[j];
+            C[i * cols + j] = v > 0 ? v : 0;
+        }
+    }
+}
+
+// Post-GEMM epilogue on INT32 sums, applied per element in this order: add
+// bias[col] saturating to INT32 (like Gemmini's accumulator; vsadd on Ara),
+// multiply by `mult` (low 32 bits kept), arithmetic right shift by `shift`
+// rounding half up (vssra with vxrm = rnu), clamp to [lo, hi]. The INT8
+// forms then saturate to elem_t. lo = 0 makes the clamp a ReLU.
+// shift must be 0..GEMM_EPILOGUE_MAX_SHIFT: vssra.vx on 32-bit elements only
+// uses the low 5 bits of the amount, so check with gemm_epilogue_check().
+typedef struct {
+    int32_t mult;
+    uint32_t shift;
+    int32_t lo, hi;
+} gemm_epilogue_t;
+
+#define GEMM_EPILOGUE_MAX_SHIFT 31
+
+// Returns 0 if the Ara epilogues can match epilogue_elem() for `ep`, -1 otherwise
+static inline int gemm_epilogue_check(const gemm_epilogue_t* ep) {
+    return ep->shift <= GEMM_EPILOGUE_MAX_SHIFT ? 0 : -1;
+}
+
+static inline int32_t epilogue_elem(int32_t x, int32_t bias, const gemm_epilogue_t* ep) {
+    int64_t sum = (int64_t)x + bias;
+    if (sum > INT32_MAX) sum = INT32_MAX;
+    if (sum < INT32_MIN) sum = INT32_MIN;
+    int32_t v = (int32_t)((uint32_t)sum * (uint32_t)ep->mult);
+    if (ep->shift) v = (int32_t)(((int64_t)v + (1LL << (ep->shift - 1))) >> ep->shift);
+    if (v < ep->lo) v = ep->lo;
+    if (v > ep->hi) v = ep->hi;
+    return v;
+}
+
+// Scalar epilogue over a rows x cols INT32 output, reference for the Ara
+// epilogues below; either output may be NULL
+static inline void scalar_epilogue(const int32_t* C, const int32_t* bias, int32_t* out32,
+                                   elem_t* out8, size_t rows, size_t cols,
+                                   const gemm_epilogue_t* ep) {
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            int32_t v = epilogue_elem(C[i * cols + j], bias[j], ep);
+            if (out32) out32[i * cols + j] = v;
+            if (out8) out8[i * cols + j] = GEMMINI_SATURATE(v);
+        }
+    }
+}
+
+// CPU-side requantization pass over an INT32 output (the Rocket fallback)
+static inline void requantize_int32(const acc_t* in, elem_t* out, size_t len,
+                                    acc_scale_t scale, int act) {
+    for (size_t i = 0; i < len; i++) {
+        out[i] = requant_acc(in[i], scale, act);
+    }
+}
+
+// Scalar INT8 matmul with per-layer scale + activation, bit-exact against the
+// Gemmini mvout path
+static inline void scalar_matmul_int8_requant(const elem_t* A, const elem_t* B, elem_t* C,
+                                              size_t M, size_t N, size_t K,
+                                              acc_scale_t scale, int act) {
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            acc_t sum = 0;
+            for (size_t k = 0; k < K; k++) {
+                sum += (acc_t)A[i * K + k] * (acc_t)B[k * N + j];
+            }
+            C[i * N + j] = requant_acc(sum, scale, act);
+        }
+    }
+}
+
+// ============================================================================
+// Ara Vector Operations using RVV Intrinsics (Inline Assembly)
+// ============================================================================
+
+// Ara Vector SAXPY: y = a*x + y using RVV instructions
+// Using simpler assembly that should work with Ara
+// Requires compilation with -march=rv64gcv flag
+static inline void ara_vector_saxpy(int32_t a, int32_t* x, int32_t* y, size_t n) {
+    size_t vl;
+    
+    while (n > 0) {
+        // Set vector length for 32-bit elements, LMUL=1
+        asm volatile(
+            "vsetvli %0, %1, e32, m1, ta, ma"
+            : "=r"(vl)
+            : "r"(n)
+        );
+        
+        // Load x vector into v1
+        asm volatile(
+            "vle32.v v1, (%0)"
+            :
+            : "r"(x)
+            : "memory", "v1"
+        );
+        
+        // Load y vector into v2
+        asm volatile(
+            "vle32.v v2, (%0)"
+            :
+            : "r"(y)
+            : "memory", "v2"
+        );
+        
+        // v3 = a * v1 (scalar-vector multiply)
+        asm volatile(
+            "vmul.vx v3, v1, %0"
+            :
+            : "r"(a)
+            : "v3"
+        );
+        
+        // v2 = v3 + v2 (y = a*x + y)
+        asm volatile(
+            "vadd.vv v2, v3, v2"
+            :
+            :
+            : "v2"
+        );
+        
+        // Store result back to y
+        asm volatile(
+            "vse32.v v2, (%0)"
+            :
+            : "r"(y)
+            : "memory"
+        );
+        
+        // Advance pointers
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+}
+
+// Fused Ara SAXPY: one asm block per strip (vsetvli, two loads, vmacc.vx,
+// store) so no compiler-scheduled code sits between the vector ops. x lives
+// in v8 and y in v16; both are aligned register groups for every LMUL up to
+// m8, at which point they cover v8-v23. Larger LMUL means fewer, longer
+// strips, i.e. fewer vsetvli/loop iterations per element.
+#define ARA_SAXPY_FUSED(lmul)                                                   \
+static inline void ara_vector_saxpy_fused_##lmul(int32_t a, int32_t* x,         \
+                                                 int32_t* y, size_t n) {        \
+    while (n > 0) {                                                             \
+        size_t vl;                                                              \
+        asm volatile(                                                           \
+            "vsetvli %[vl], %[avl], e32, " #lmul ", ta, ma\n\t"                 \
+            "vle32.v v8, (%[x])\n\t"                                            \
+            "vle32.v v16, (%[y])\n\t"                                           \
+            "vmacc.vx v16, %[a], v8\n\t"                                        \
+            "vse32.v v16, (%[y])"                                               \
+            : [vl] "=&r"(vl)                                                    \
+            : [avl] "r"(n), [x] "r"(x), [y] "r"(y), [a] "r"(a)                  \
+            : "memory",                                                         \
+              "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",             \
+              "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23"            \
+        );                                                                      \
+        x += vl;                                                                \
+        y += vl;                                                                \
+        n -= vl;                                                                \
+    }                                                                           \
+}
+
+ARA_SAXPY_FUSED(m1)
+ARA_SAXPY_FUSED(m2)
+ARA_SAXPY_FUSED(m4)
+ARA_SAXPY_FUSED(m8)
+
+// Fused SAXPY with LMUL chosen at run time (1, 2, 4 or 8; others use m1)
+static inline void ara_vector_saxpy_fused(int32_t a, int32_t* x, int32_t* y, size_t n, size_t lmul) {
+    switch (lmul) {
+        case 8: ara_vector_saxpy_fused_m8(a, x, y, n); break;
+        case 4: ara_vector_saxpy_fused_m4(a, x, y, n); break;
+        case 2: ara_vector_saxpy_fused_m2(a, x, y, n); break;
+        default: ara_vector_saxpy_fused_m1(a, x, y, n); break;
+    }
+}
+
+// Ara Vector Dot Product: sum(x[i] * y[i]) with 64-bit accumulation
+// vwmacc.vv widens each INT32 product into an e64/m2 accumulator group
+// (v8-v9); the loop runs tail-undisturbed so a short final strip keeps the
+// partial sums of the upper lanes, then one vredsum.vs folds all lanes.
+static inline int64_t ara_vector_dot(int32_t* x, int32_t* y, size_t n) {
+    size_t vl;
+    int64_t sum;
+
+    // Zero every lane of the accumulator
+    asm volatile(
+        "vsetvli %0, zero, e64, m2, ta, ma\n\t"
+        "vmv.v.i v8, 0"
+        : "=r"(vl)
+        :
+        : "v8", "v9"
+    );
+
+    while (n > 0) {
+        asm volatile(
+            "vsetvli %0, %1, e32, m1, tu, ma\n\t"
+            "vle32.v v4, (%2)\n\t"
+            "vle32.v v5, (%3)\n\t"
+            "vwmacc.vv v8, v4, v5"
+            : "=&r"(vl)
+            : "r"(n), "r"(x), "r"(y)
+            : "memory", "v4", "v5", "v8", "v9"
+        );
+
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+
+    // Reduce across the full register group
+    asm volatile(
+        "vsetvli %0, zero, e64, m2, ta, ma\n\t"
+        "vmv.s.x v12, zero\n\t"
+        "vredsum.vs v12, v8, v12\n\t"
+        "vmv.x.s %1, v12"
+        : "=&r"(vl), "=r"(sum)
+        :
+        : "v12"
+    );
+
+    return sum;
+}
+
+// ----------------------------------------------------------------------------
+// Ara Vector Matmul: C = A * B, row-major A (MxK), B (KxN), C (MxN)
+// ----------------------------------------------------------------------------
+// Outer-product formulation: for a strip of vl output columns, each step k
+// loads row k of B once and does C[i][j:j+vl] += A[i][k] * B[k][j:j+vl] for
+// ARA_MM_ROWS rows of A with vmacc.vx. Accumulators are e32/m4 groups
+// (v8, v12, v16, v20) and the B row is v24. The whole K loop for a strip is
+// a single asm block so the accumulators never live across compiler-visible
+// code. Rows past M alias the last valid row; they recompute and store the
+// same values, which avoids a separate remainder kernel.
+
+#define ARA_MM_ROWS 4
+
+static inline void ara_vector_matmul_int32(const int32_t* A, const int32_t* B, int32_t* C,
+                                           size_t M, size_t N, size_t K) {
+    if (M == 0 || K == 0) return;
+
+    for (size_t i = 0; i < M; i += ARA_MM_ROWS) {
+        const size_t r1 = MIN(i + 1, M - 1), r2 = MIN(i + 2, M - 1), r3 = MIN(i + 3, M - 1);
+
+        for (size_t j = 0; j < N; ) {
+            size_t vl;
+            size_t k = K;
+            const int32_t* b = B + j;
+            const int32_t* p0 = A + i * K;
+            const int32_t* p1 = A + r1 * K;
+            const int32_t* p2 = A + r2 * K;
+            const int32_t* p3 = A + r3 * K;
+
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                "vmv.v.i v8, 0\n\t"
+                "vmv.v.i v12, 0\n\t"
+                "vmv.v.i v16, 0\n\t"
+                "vmv.v.i v20, 0\n\t"
+                "1:\n\t"
+                "vle32.v v24, (%[b])\n\t"
+                "lw t0, 0(%[p0])\n\t"
+                "lw t1, 0(%[p1])\n\t"
+                "lw t2, 0(%[p2])\n\t"
+                "lw t3, 0(%[p3])\n\t"
+                "vmacc.vx v8, t0, v24\n\t"
+                "vmacc.vx v12, t1, v24\n\t"
+                "vmacc.vx v16, t2, v24\n\t"
+                "vmacc.vx v20, t3, v24\n\t"
+                "add %[b], %[b], %[bstride]\n\t"
+                "addi %[p0], %[p0], 4\n\t"
+                "addi %[p1], %[p1], 4\n\t"
+                "addi %[p2], %[p2], 4\n\t"
+                "addi %[p3], %[p3], 4\n\t"
+                "addi %[k], %[k], -1\n\t"
+                "bnez %[k], 1b\n\t"
+                "vse32.v v8, (%[c0])\n\t"
+                "vse32.v v12, (%[c1])\n\t"
+                "vse32.v v16, (%[c2])\n\t"
+                "vse32.v v20, (%[c3])"
+                : [vl] "=&r"(vl), [b] "+r"(b), [k] "+r"(k),
+                  [p0] "+r"(p0), [p1] "+r"(p1), [p2] "+r"(p2), [p3] "+r"(p3)
+                : [avl] "r"(N - j), [bstride] "r"(N * sizeof(int32_t)),
+                  [c0] "r"(C + i * N + j), [c1] "r"(C + r1 * N + j),
+                  [c2] "r"(C + r2 * N + j), [c3] "r"(C + r3 * N + j)
+                : "t0", "t1", "t2", "t3", "memory",
+                  "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",
+                  "v24", "v25", "v26", "v27"
+            );
+
+            j += vl;
+        }
+    }
+}
+
+// One 4-row strip of the INT8 x INT8 -> INT32 matmul. `bload` fetches vl
+// bytes of the current B row into v4: vle8 for row-major B, vlse8 with a
+// stride of ldb bytes for transposed B.
+#define ARA_MATMUL_INT8_STRIP(bload)                                           \
+    asm volatile(                                                              \
+        "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"                           \
+        "vmv.v.i v8, 0\n\t"                                                    \
+        "vmv.v.i v12, 0\n\t"                                                   \
+        "vmv.v.i v16, 0\n\t"                                                   \
+        "vmv.v.i v20, 0\n\t"                                                   \
+        "1:\n\t"                                                               \
+        bload "\n\t"                                                           \
+        "vsext.vf4 v24, v4\n\t"                                                \
+        "lb t0, 0(%[p0])\n\t"                                                  \
+        "lb t1, 0(%[p1])\n\t"                                                  \
+        "lb t2, 0(%[p2])\n\t"                                                  \
+        "lb t3, 0(%[p3])\n\t"                                                  \
+        "vmacc.vx v8, t0, v24\n\t"                                             \
+        "vmacc.vx v12, t1, v24\n\t"                                            \
+        "vmacc.vx v16, t2, v24\n\t"                                            \
+        "vmacc.vx v20, t3, v24\n\t"                                            \
+        "add %[b], %[b], %[bstep]\n\t"                                         \
+        "addi %[p0], %[p0], 1\n\t"                                             \
+        "addi %[p1], %[p1], 1\n\t"                                             \
+        "addi %[p2], %[p2], 1\n\t"                                             \
+        "addi %[p3], %[p3], 1\n\t"                                             \
+        "addi %[k], %[k], -1\n\t"                                              \
+        "bnez %[k], 1b\n\t"                                                    \
+        "vse32.v v8, (%[c0])\n\t"                                              \
+        "vse32.v v12, (%[c1])\n\t"                                             \
+        "vse32.v v16, (%[c2])\n\t"                                             \
+        "vse32.v v20, (%[c3])"                                                 \
+        : [vl] "=&r"(vl), [b] "+r"(b), [k] "+r"(k),                            \
+          [p0] "+r"(p0), [p1] "+r"(p1), [p2] "+r"(p2), [p3] "+r"(p3)           \
+        : [avl] "r"(N - j), [bstep] "r"(bstep), [bstride] "r"(bstride),        \
+          [c0] "r"(C + i * ldc + j), [c1] "r"(C + r1 * ldc + j),               \
+          [c2] "r"(C + r2 * ldc + j), [c3] "r"(C + r3 * ldc + j)               \
+        : "t0", "t1", "t2", "t3", "memory", "v4",                              \
+          "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",                \
+          "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",              \
+          "v24", "v25", "v26", "v27")
+
+// INT8 x INT8 -> INT32 matmul with explicit leading dimensions (elements).
+// B is KxN with row pitch ldb, or with trans_b NxK with row pitch ldb, in
+// which case each B row is gathered with a strided load.
+static inline void ara_vector_matmul_int8_ld(const int8_t* A, size_t lda,
+                                             const int8_t* B, size_t ldb, int trans_b,
+                                             int32_t* C, size_t ldc,
+                                             size_t M, size_t N, size_t K) {
+    if (M == 0 || K == 0) return;
+
+    // Bytes between consecutive k (bstep) and consecutive j (bstride) in B
+    const size_t bstep = trans_b ? sizeof(int8_t) : ldb * sizeof(int8_t);
+    const size_t bstride = trans_b ? ldb * sizeof(int8_t) : sizeof(int8_t);
+
+    for (size_t i = 0; i < M; i += ARA_MM_ROWS) {
+        const size_t r1 = MIN(i + 1, M - 1), r2 = MIN(i + 2, M - 1), r3 = MIN(i + 3, M - 1);
+
+        for (size_t j = 0; j < N; ) {
+            size_t vl;
+            size_t k = K;
+            const int8_t* b = B + j * bstride;
+            const int8_t* p0 = A + i * lda;
+            const int8_t* p1 = A + r1 * lda;
+            const int8_t* p2 = A + r2 * lda;
+            const int8_t* p3 = A + r3 * lda;
+
+            if (trans_b) {
+                ARA_MATMUL_INT8_STRIP("vlse8.v v4, (%[b]), %[bstride]");
+            } else {
+                ARA_MATMUL_INT8_STRIP("vle8.v v4, (%[b])");
+            }
+
+            j += vl;
+        }
+    }
+}
+
+// INT8 x INT8 -> INT32 variant: B rows are loaded as bytes (EMUL=1 into v4)
+// and sign-extended to the e32/m4 working width with vsext.vf4.
+static inline void ara_vector_matmul_int8(const int8_t* A, const int8_t* B, int32_t* C,
+                                          size_t M, size_t N, size_t K) {
+    ara_vector_matmul_int8_ld(A, K, B, N, 0, C, N, M, N, K);
+}
+
+// Same, driven by a resolved gemm_layout_t (INT32 C with pitch ldc)
+static inline void ara_vector_matmul_int8_layout(const gemm_layout_t* l, const int8_t* A,
+                                                 const int8_t* B, int32_t* C) {
+    ara_vector_matmul_int8_ld(A, l->lda, B, l->ldb, l->trans_b, C, l->ldc, l->m, l->n, l->k);
+}
+
+// FP32 SAXPY with vfmacc.vf, e32/m4 (x in v8, y in v16)
+static inline void ara_vector_saxpy_fp32(float a, const float* x, float* y, size_t n) {
+    while (n > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+            "vle32.v v8, (%[x])\n\t"
+            "vle32.v v16, (%[y])\n\t"
+            "vfmacc.vf v16, %[a], v8\n\t"
+            "vse32.v v16, (%[y])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(n), [x] "r"(x), [y] "r"(y), [a] "f"(a)
+            : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v18", "v19"
+        );
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+}
+
+// BF16 SAXPY without vector BF16 instructions: each BF16 strip is widened
+// to FP32 by zero-extending and shifting left 16, computed with vfmacc.vf,
+// rounded to nearest even in the integer domain (as bf16_from_fp32) and
+// narrowed back with vnsrl. e32/m4 and e16/m2 share the vl.
+static inline void ara_vector_saxpy_bf16(float a, const bf16_t* x, bf16_t* y, size_t n) {
+    const size_t round = 0x7FFF;
+    while (n > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+            "vle16.v v4, (%[x])\n\t"
+            "vle16.v v6, (%[y])\n\t"
+            "vzext.vf2 v8, v4\n\t"
+            "vzext.vf2 v16, v6\n\t"
+            "vsll.vi v8, v8, 16\n\t"
+            "vsll.vi v16, v16, 16\n\t"
+            "vfmacc.vf v16, %[a], v8\n\t"
+            "vsrl.vi v24, v16, 16\n\t"
+            "vand.vi v24, v24, 1\n\t"
+            "vadd.vv v16, v16, v24\n\t"
+            "vadd.vx v16, v16, %[rnd]\n\t"
+            "vsetvli zero, zero, e16, m2, ta, ma\n\t"
+            "vnsrl.wi v4, v16, 16\n\t"
+            "vse16.v v4, (%[y])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(n), [x] "r"(x), [y] "r"(y), [a] "f"(a), [rnd] "r"(round)
+            : "memory", "v4", "v5", "v6", "v7", "v8", "v9", "v10", "v11",
+              "v16", "v17", "v18", "v19", "v24", "v25", "v26", "v27"
+        );
+        x += vl;
+        y += vl;
+        n -= vl;
+    }
+}
+
+// One 4-row strip of the FP32-accumulating matmuls, the outer-product
+// scheme of ara_vector_matmul_int32 with vfmacc.vf. `bload` leaves the
+// current B row as FP32 in v24; `aload` puts A[r][k] of the four rows in
+// ft0-ft3 and `asz` is the A element size in bytes.
+#define ARA_MATMUL_FP_STRIP(bload, aload, asz)                                 \
+    asm volatile(                                                              \
+        "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"                           \
+        "vmv.v.i v8, 0\n\t"                                                    \
+        "vmv.v.i v12, 0\n\t"                                                   \
+        "vmv.v.i v16, 0\n\t"                                                   \
+        "vmv.v.i v20, 0\n\t"                                                   \
+        "1:\n\t"                                                               \
+        bload "\n\t"                                                           \
+        aload                                                                  \
+        "vfmacc.vf v8, ft0, v24\n\t"                                           \
+        "vfmacc.vf v12, ft1, v24\n\t"                                          \
+        "vfmacc.vf v16, ft2, v24\n\t"                                          \
+        "vfmacc.vf v20, ft3, v24\n\t"                                          \
+        "add %[b], %[b], %[bstride]\n\t"                                       \
+        "addi %[p0], %[p0], " asz "\n\t"                                       \
+        "addi %[p1], %[p1], " asz "\n\t"                                       \
+        "addi %[p2], %[p2], " asz "\n\t"                                       \
+        "addi %[p3], %[p3], " asz "\n\t"                                       \
+        "addi %[k], %[k], -1\n\t"                                              \
+        "bnez %[k], 1b\n\t"                                                    \
+        "vse32.v v8, (%[c0])\n\t"                                              \
+        "vse32.v v12, (%[c1])\n\t"                                             \
+        "vse32.v v16, (%[c2])\n\t"                                             \
+        "vse32.v v20, (%[c3])"                                                 \
+        : [vl] "=&r"(vl), [b] "+r"(b), [k] "+r"(k),                            \
+          [p0] "+r"(p0), [p1] "+r"(p1), [p2] "+r"(p2), [p3] "+r"(p3)           \
+        : [avl] "r"(N - j), [bstride] "r"(bstride),                            \
+          [c0] "r"(C + i * N + j), [c1] "r"(C + r1 * N + j),                   \
+          [c2] "r"(C + r2 * N + j), [c3] "r"(C + r3 * N + j)                   \
+        : "t0", "t1", "t2", "t3", "ft0", "ft1", "ft2", "ft3", "memory",        \
+          "v4", "v5", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",    \
+          "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",              \
+          "v24", "v25", "v26", "v27")
+
+// FP32-accumulating matmul over in_t operands: MxK * KxN -> FP32
+#define ARA_MATMUL_FP(name, in_t, bload, aload, asz)                           \
+static inline void name(const in_t* A, const in_t* B, float* C,                \
+                        size_t M, size_t N, size_t K) {                        \
+    if (M == 0 || K == 0) return;                                              \
+    const size_t bstride = N * sizeof(in_t);                                   \
+    for (size_t i = 0; i < M; i += ARA_MM_ROWS) {                              \
+        const size_t r1 = MIN(i + 1, M - 1), r2 = MIN(i + 2, M - 1),           \
+                     r3 = MIN(i + 3, M - 1);                                   \
+        for (size_t j = 0; j < N; ) {                                          \
+            size_t vl;                                                         \
+            size_t k = K;                                                      \
+            const in_t* b = B + j;                                             \
+            const in_t* p0 = A + i * K;                                        \
+            const in_t* p1 = A + r1 * K;                                       \
+            const in_t* p2 = A + r2 * K;                                       \
+            const in_t* p3 = A + r3 * K;                                       \
+            ARA_MATMUL_FP_STRIP(bload, aload, asz);                            \
+            j += vl;                                                           \
+        }                                                                      \
+    }                                                                          \
+}
+
+// ara_vector_matmul_fp32: FP32 operands
+ARA_MATMUL_FP(ara_vector_matmul_fp32, float,
+              "vle32.v v24, (%[b])",
+              "flw ft0, 0(%[p0])\n\t"
+              "flw ft1, 0(%[p1])\n\t"
+              "flw ft2, 0(%[p2])\n\t"
+              "flw ft3, 0(%[p3])\n\t",
+              "4")
+
+// ara_vector_matmul_bf16: BF16 operands, FP32 output. B rows are widened
+// as in ara_vector_saxpy_bf16; A elements reach the FP registers through
+// the integer side.
+ARA_MATMUL_FP(ara_vector_matmul_bf16, bf16_t,
+              "vle16.v v4, (%[b])\n\t"
+              "vzext.vf2 v24, v4\n\t"
+              "vsll.vi v24, v24, 16",
+              "lhu t0, 0(%[p0])\n\t"
+              "lhu t1, 0(%[p1])\n\t"
+              "lhu t2, 0(%[p2])\n\t"
+              "lhu t3, 0(%[p3])\n\t"
+              "slli t0, t0, 16\n\t"
+              "slli t1, t1, 16\n\t"
+              "slli t2, t2, 16\n\t"
+              "slli t3, t3, 16\n\t"
+              "fmv.w.x ft0, t0\n\t"
+              "fmv.w.x ft1, t1\n\t"
+              "fmv.w.x ft2, t2\n\t"
+              "fmv.w.x ft3, t3\n\t",
+              "2")
+
+// Ara GEMM epilogue: C[i][j] = max(C[i][j] + bias[j], 0) in place on a
+// row-major INT32 output, one fused asm block per strip (e32/m4, C in v8,
+// bias in v16)
+static inline void ara_bias_relu_int32(int32_t* C, const int32_t* bias, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; i++) {
+        int32_t* c = C + i * cols;
+        const int32_t* b = bias;
+        size_t n = cols;
+        while (n > 0) {
+            size_t vl;
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                "vle32.v v8, (%[c])\n\t"
+                "vle32.v v16, (%[b])\n\t"
+                "vadd.vv v8, v8, v16\n\t"
+                "vmax.vx v8, v8, zero\n\t"
+                "vse32.v v8, (%[c])"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [c] "r"(c), [b] "r"(b)
+                : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v18", "v19"
+            );
+            c += vl;
+            b += vl;
+            n -= vl;
+        }
+    }
+}
+
+// ============================================================================
+// Ara Epilogues (bias, scale/shift, ReLU/clamp, narrow to INT8)
+// ============================================================================
+
+// Each op exists as its own pass over C, the way an epilogue is built from
+// single-op kernels like ara_vector_saxpy, and fused into one strip-mined
+// pass that loads C once and stores it (or its INT8 narrowing) once. The
+// fused forms match scalar_epilogue() bit for bit. All use e32/m4 with C in
+// v8 and the bias strip in v16.
+
+// Round-half-up for vssra, as epilogue_elem() assumes
+static inline void ara_set_vxrm_rnu(void) {
+    asm volatile("csrwi vxrm, 0");
+}
+
+// C[i][j] += bias[j], saturating
+static inline void ara_epi_bias_int32(int32_t* C, const int32_t* bias, size_t rows, size_t cols) {
+    for (size_t i = 0; i < rows; i++) {
+        int32_t* c = C + i * cols;
+        const int32_t* b = bias;
+        size_t n = cols;
+        while (n > 0) {
+            size_t vl;
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                "vle32.v v8, (%[c])\n\t"
+                "vle32.v v16, (%[b])\n\t"
+                "vsadd.vv v8, v8, v16\n\t"
+                "vse32.v v8, (%[c])"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [c] "r"(c), [b] "r"(b)
+                : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v18", "v19"
+            );
+            c += vl;
+            b += vl;
+            n -= vl;
+        }
+    }
+}
+
+// C[i] = (C[i] * mult) >> shift, rounding half up
+static inline void ara_epi_scale_int32(int32_t* C, size_t len, int32_t mult, uint32_t shift) {
+    ara_set_vxrm_rnu();
+    while (len > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+            "vle32.v v8, (%[c])\n\t"
+            "vmul.vx v8, v8, %[m]\n\t"
+            "vssra.vx v8, v8, %[s]\n\t"
+            "vse32.v v8, (%[c])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(len), [c] "r"(C), [m] "r"(mult), [s] "r"((size_t)shift)
+            : "memory", "v8", "v9", "v10", "v11"
+        );
+        C += vl;
+        len -= vl;
+    }
+}
+
+// C[i] = min(max(C[i], lo), hi)
+static inline void ara_epi_clamp_int32(int32_t* C, size_t len, int32_t lo, int32_t hi) {
+    while (len > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+            "vle32.v v8, (%[c])\n\t"
+            "vmax.vx v8, v8, %[lo]\n\t"
+            "vmin.vx v8, v8, %[hi]\n\t"
+            "vse32.v v8, (%[c])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(len), [c] "r"(C), [lo] "r"(lo), [hi] "r"(hi)
+            : "memory", "v8", "v9", "v10", "v11"
+        );
+        C += vl;
+        len -= vl;
+    }
+}
+
+// out[i] = saturate_int8(C[i]): two saturating vnclip steps, e32 -> e16 -> e8.
+// The SEW/LMUL ratio stays 8, so vl carries over unchanged.
+static inline void ara_epi_narrow_int8(const int32_t* C, elem_t* out, size_t len) {
+    while (len > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+            "vle32.v v8, (%[c])\n\t"
+            "vsetvli zero, zero, e16, m2, ta, ma\n\t"
+            "vnclip.wi v16, v8, 0\n\t"
+            "vsetvli zero, zero, e8, m1, ta, ma\n\t"
+            "vnclip.wi v20, v16, 0\n\t"
+            "vse8.v v20, (%[o])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(len), [c] "r"(C), [o] "r"(out)
+            : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v20"
+        );
+        C += vl;
+        out += vl;
+        len -= vl;
+    }
+}
+
+// The unfused chains: one pass per op
+static inline void ara_epilogue_int32_unfused(int32_t* C, const int32_t* bias, size_t rows,
+                                              size_t cols, const gemm_epilogue_t* ep) {
+    ara_epi_bias_int32(C, bias, rows, cols);
+    ara_epi_scale_int32(C, rows * cols, ep->mult, ep->shift);
+    ara_epi_clamp_int32(C, rows * cols, ep->lo, ep->hi);
+}
+
+static inline void ara_epilogue_int8_unfused(int32_t* C, const int32_t* bias, elem_t* out,
+                                             size_t rows, size_t cols, const gemm_epilogue_t* ep) {
+    ara_epilogue_int32_unfused(C, bias, rows, cols, ep);
+    ara_epi_narrow_int8(C, out, rows * cols);
+}
+
+// Fused bias + scale + clamp, one load and one store of C per element.
+// With out8 non-NULL the result is narrowed into out8 and C is left as is;
+// otherwise C is updated in place.
+static inline void ara_epilogue_fused(int32_t* C, const int32_t* bias, elem_t* out8,
+                                      size_t rows, size_t cols, const gemm_epilogue_t* ep) {
+    const size_t shift = ep->shift;
+    ara_set_vxrm_rnu();
+    for (size_t i = 0; i < rows; i++) {
+        int32_t* c = C + i * cols;
+        elem_t* o = out8 ? out8 + i * cols : NULL;
+        const int32_t* b = bias;
+        size_t n = cols;
+        while (n > 0) {
+            size_t vl;
+            if (o) {
+                asm volatile(
+                    "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                    "vle32.v v8, (%[c])\n\t"
+                    "vle32.v v16, (%[b])\n\t"
+                    "vsadd.vv v8, v8, v16\n\t"
+                    "vmul.vx v8, v8, %[m]\n\t"
+                    "vssra.vx v8, v8, %[s]\n\t"
+                    "vmax.vx v8, v8, %[lo]\n\t"
+                    "vmin.vx v8, v8, %[hi]\n\t"
+                    "vsetvli zero, zero, e16, m2, ta, ma\n\t"
+                    "vnclip.wi v16, v8, 0\n\t"
+                    "vsetvli zero, zero, e8, m1, ta, ma\n\t"
+                    "vnclip.wi v20, v16, 0\n\t"
+                    "vse8.v v20, (%[o])"
+                    : [vl] "=&r"(vl)
+                    : [avl] "r"(n), [c] "r"(c), [b] "r"(b), [o] "r"(o),
+                      [m] "r"(ep->mult), [s] "r"(shift), [lo] "r"(ep->lo), [hi] "r"(ep->hi)
+                    : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v18", "v19", "v20"
+                );
+                o += vl;
+            } else {
+                asm volatile(
+                    "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                    "vle32.v v8, (%[c])\n\t"
+                    "vle32.v v16, (%[b])\n\t"
+                    "vsadd.vv v8, v8, v16\n\t"
+                    "vmul.vx v8, v8, %[m]\n\t"
+                    "vssra.vx v8, v8, %[s]\n\t"
+                    "vmax.vx v8, v8, %[lo]\n\t"
+                    "vmin.vx v8, v8, %[hi]\n\t"
+                    "vse32.v v8, (%[c])"
+                    : [vl] "=&r"(vl)
+                    : [avl] "r"(n), [c] "r"(c), [b] "r"(b),
+                      [m] "r"(ep->mult), [s] "r"(shift), [lo] "r"(ep->lo), [hi] "r"(ep->hi)
+                    : "memory", "v8", "v9", "v10", "v11", "v16", "v17", "v18", "v19"
+                );
+            }
+            c += vl;
+            b += vl;
+            n -= vl;
+        }
+    }
+}
+
+// ============================================================================
+// Size-Specialized Kernels and Dispatch
+// ============================================================================
+
+// Fixed-size copies of the generic scalar and Ara kernels, generated for the
+// shapes listed below and reached through the *_dispatch() wrappers, which
+// fall back to the generic kernel for every other size. Override a list
+// with e.g. -D'BENCH_SPECIAL_DIMS(X)=X(16) X(32)'.
+//
+// Square N x N x N INT32 matmuls (N <= 511 for the Ara K unroll)
+#ifndef BENCH_SPECIAL_DIMS
+#define BENCH_SPECIAL_DIMS(X) X(4) X(8) X(16) X(32)
+#endif
+// SAXPY lengths
+#ifndef BENCH_SPECIAL_LENS
+#define BENCH_SPECIAL_LENS(X) X(64) X(256) X(1024)
+#endif
+
+// Scalar matmul with constant bounds; the K loop is unrolled completely,
+// so each output is one straight-line multiply-add chain
+#define SCALAR_MATMUL_INT32_FIXED(n)                                           \
+static inline void scalar_matmul_int32_n##n(const int32_t* A,                  \
+                                            const int32_t* B, int32_t* C) {    \
+    for (size_t i = 0; i < (n); i++) {                                         \
+        for (size_t j = 0; j < (n); j++) {                                     \
+            int64_t sum = 0;                                                   \
+            _Pragma("GCC unroll 512")                                          \
+            for (size_t k = 0; k < (n); k++) {                                 \
+                sum += (int64_t)A[i * (n) + k] * (int64_t)B[k * (n) + j];      \
+            }                                                                  \
+            C[i * (n) + j] = (int32_t)sum;                                     \
+        }                                                                      \
+    }                                                                          \
+}
+
+// Scalar SAXPY with a constant trip count, unrolled 16 times (a full unroll
+// of the longer lengths would mostly add I$ misses)
+#define SCALAR_SAXPY_FIXED(n)                                                  \
+static inline void scalar_saxpy_n##n(int32_t a, const int32_t* x,              \
+                                     int32_t* y) {                             \
+    _Pragma("GCC unroll 16")                                                   \
+    for (size_t i = 0; i < (n); i++) {                                         \
+        y[i] = a * x[i] + y[i];                                                \
+    }                                                                          \
+}
+
+// ara_vector_matmul_int32 with the K loop unrolled by the assembler: .rept
+// emits one step per k with A offsets as immediates, so there is no loop
+// counter, no branch and no A pointer update left. The strip loop over
+// columns stays, since VLMAX is only known at run time.
+#define ARA_MATMUL_INT32_FIXED(n)                                              \
+_Static_assert((n) * 4 < 2048, "A offsets must fit a 12-bit immediate");       \
+static inline void ara_vector_matmul_int32_n##n(const int32_t* A,              \
+                                                const int32_t* B,              \
+                                                int32_t* C) {                  \
+    for (size_t i = 0; i < (n); i += ARA_MM_ROWS) {                            \
+        const size_t r1 = MIN(i + 1, (n) - 1), r2 = MIN(i + 2, (n) - 1),       \
+                     r3 = MIN(i + 3, (n) - 1);                                 \
+        for (size_t j = 0; j < (n); ) {                                        \
+            size_t vl;                                                         \
+            const int32_t* b = B + j;                                          \
+            asm volatile(                                                      \
+                "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"                   \
+                "vmv.v.i v8, 0\n\t"                                            \
+                "vmv.v.i v12, 0\n\t"                                           \
+                "vmv.v.i v16, 0\n\t"                                           \
+                "vmv.v.i v20, 0\n\t"                                           \
+                ".set .Lara_koff, 0\n\t"                                       \
+                ".rept " #n "\n\t"                                             \
+                "vle32.v v24, (%[b])\n\t"                                      \
+                "lw t0, .Lara_koff(%[p0])\n\t"                                 \
+                "lw t1, .Lara_koff(%[p1])\n\t"                                 \
+                "lw t2, .Lara_koff(%[p2])\n\t"                                 \
+                "lw t3, .Lara_koff(%[p3])\n\t"                                 \
+                "vmacc.vx v8, t0, v24\n\t"                                     \
+                "vmacc.vx v12, t1, v24\n\t"                                    \
+                "vmacc.vx v16, t2, v24\n\t"                                    \
+                "vmacc.vx v20, t3, v24\n\t"                                    \
+                "add %[b], %[b], %[bstride]\n\t"                               \
+                ".set .Lara_koff, .Lara_koff + 4\n\t"                          \
+                ".endr\n\t"                                                    \
+                "vse32.v v8, (%[c0])\n\t"                                      \
+                "vse32.v v12, (%[c1])\n\t"                                     \
+                "vse32.v v16, (%[c2])\n\t"                                     \
+                "vse32.v v20, (%[c3])"                                         \
+                : [vl] "=&r"(vl), [b] "+r"(b)                                  \
+                : [avl] "r"((n) - j), [bstride] "r"((n) * sizeof(int32_t)),    \
+                  [p0] "r"(A + i * (n)), [p1] "r"(A + r1 * (n)),               \
+                  [p2] "r"(A + r2 * (n)), [p3] "r"(A + r3 * (n)),              \
+                  [c0] "r"(C + i * (n) + j), [c1] "r"(C + r1 * (n) + j),       \
+                  [c2] "r"(C + r2 * (n) + j), [c3] "r"(C + r3 * (n) + j)       \
+                : "t0", "t1", "t2", "t3", "memory",                            \
+                  "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",        \
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",      \
+                  "v24", "v25", "v26", "v27"                                   \
+            );                                                                 \
+            j += vl;                                                           \
+        }                                                                      \
+    }                                                                          \
+}
+
+#define BENCH_EMIT_MATMUL_FIXED(n) SCALAR_MATMUL_INT32_FIXED(n) ARA_MATMUL_INT32_FIXED(n)
+BENCH_SPECIAL_DIMS(BENCH_EMIT_MATMUL_FIXED)
+BENCH_SPECIAL_LENS(SCALAR_SAXPY_FIXED)
+
+typedef struct {
+    size_t n;
+    void (*scalar)(const int32_t* A, const int32_t* B, int32_t* C);
+    void (*ara)(const int32_t* A, const int32_t* B, int32_t* C);
+} matmul_int32_special_t;
+
+typedef struct {
+    size_t n;
+    void (*scalar)(int32_t a, const int32_t* x, int32_t* y);
+} saxpy_special_t;
+
+#define BENCH_MATMUL_SPECIAL_ENTRY(n) { (n), scalar_matmul_int32_n##n, ara_vector_matmul_int32_n##n },
+#define BENCH_SAXPY_SPECIAL_ENTRY(n) { (n), scalar_saxpy_n##n },
+
+static const matmul_int32_special_t matmul_int32_specials[] = {
+    BENCH_SPECIAL_DIMS(BENCH_MATMUL_SPECIAL_ENTRY)
+};
+static const saxpy_special_t saxpy_specials[] = {
+    BENCH_SPECIAL_LENS(BENCH_SAXPY_SPECIAL_ENTRY)
+};
+
+#define BENCH_NUM_SPECIALS(t) (sizeof(t) / sizeof((t)[0]))
+
+// Table entry for an N x N x N matmul, or NULL
+static inline const matmul_int32_special_t* matmul_int32_special(size_t M, size_t N, size_t K) {
+    if (M != N || N != K) return NULL;
+    for (size_t i = 0; i < BENCH_NUM_SPECIALS(matmul_int32_specials); i++) {
+        if (matmul_int32_specials[i].n == N) return &matmul_int32_specials[i];
+    }
+    return NULL;
+}
+
+static inline const saxpy_special_t* saxpy_special(size_t n) {
+    for (size_t i = 0; i < BENCH_NUM_SPECIALS(saxpy_specials); i++) {
+        if (saxpy_specials[i].n == n) return &saxpy_specials[i];
+    }
+    return NULL;
+}
+
+// Drop-in replacements for the generic kernels
+static inline void scalar_matmul_int32_dispatch(int32_t* A, int32_t* B, int32_t* C, size_t N) {
+    const matmul_int32_special_t* sp = matmul_int32_special(N, N, N);
+    if (sp) sp->scalar(A, B, C);
+    else scalar_matmul_int32(A, B, C, N);
+}
+
+static inline void ara_vector_matmul_int32_dispatch(const int32_t* A, const int32_t* B, int32_t* C,
+                                                    size_t M, size_t N, size_t K) {
+    const matmul_int32_special_t* sp = matmul_int32_special(M, N, K);
+    if (sp) sp->ara(A, B, C);
+    else ara_vector_matmul_int32(A, B, C, M, N, K);
+}
+
+static inline void scalar_saxpy_dispatch(int32_t a, int32_t* x, int32_t* y, size_t n) {
+    const saxpy_special_t* sp = saxpy_special(n);
+    if (sp) sp->scalar(a, x, y);
+    else scalar_saxpy(a, x, y, n);
+}
+
+// ============================================================================
+// Gemmini Single-Tile Matmul
+// ============================================================================
+
+// Load/store strides and dataflow for the single-tile kernels. A production
+// driver issues this once per layer, not per tile.
+static inline void gemmini_tile_config(void) {
+    gemmini_config_ld(DIM * sizeof(elem_t));
+    gemmini_config_st(DIM * sizeof(elem_t));
+    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
+}
+
+// Scratchpad rows of the single-tile kernels: one DIM-row tile each for A,
+// B and the output-stationary C
+#define GEMMINI_TILE_A_SP 0
+#define GEMMINI_TILE_B_SP DIM
+#define GEMMINI_TILE_C_SP (2 * DIM)
+
+_Static_assert(GEMMINI_TILE_C_SP + DIM <= BANK_NUM * BANK_ROWS,
+               "the single-tile kernels need three DIM-row tiles of scratchpad");
+
+// One tile with the configuration already in place: mvin A/B, compute,
+// mvout, fence
+static inline void gemmini_matmul_tile_hoisted(elem_t A[DIM][DIM], elem_t B[DIM][DIM],
+                                               elem_t C[DIM][DIM]) {
+    size_t A_sp = GEMMINI_TILE_A_SP, B_sp = GEMMINI_TILE_B_SP, C_sp = GEMMINI_TILE_C_SP;
+
+    gemmini_mvin(A, A_sp);
+    gemmini_mvin(B, B_sp);
+    gemmini_preload_zeros(C_sp);
+    gemmini_compute_preloaded(A_sp, B_sp);
+    gemmini_mvout(C, C_sp);
+    gemmini_fence();
+}
+
+// One DIM x DIM output-stationary tile: config, mvin A/B, compute, mvout, fence
+static inline void gemmini_matmul_tile(elem_t A[DIM][DIM], elem_t B[DIM][DIM], elem_t C[DIM][DIM]) {
+    gemmini_tile_config();
+    gemmini_matmul_tile_hoisted(A, B, C);
+}
+
+// Per-phase cycles of one tile. Every phase ends in a fence so its commands
+// have retired before the next timestamp; `fence` is the cost of a fence on
+// an already idle queue, which each phase carries once.
+typedef struct {
+    uint64_t setup;    // config_ld + config_st + config_ex
+    uint64_t mvin;     // A and B
+    uint64_t compute;  // preload_zeros + compute_preloaded
+    uint64_t mvout;    // C
+    uint64_t fence;
+} gemmini_tile_phases_t;
+
+#define GEMMINI_TILE_NUM_PHASES 5
+
+// Same commands as gemmini_matmul_tile, timed phase by phase. The total is
+// larger than the unphased run because the phases can no longer overlap.
+static inline void gemmini_matmul_tile_phased(elem_t A[DIM][DIM], elem_t B[DIM][DIM],
+                                              elem_t C[DIM][DIM], gemmini_tile_phases_t* ph) {
+    size_t A_sp = GEMMINI_TILE_A_SP, B_sp = GEMMINI_TILE_B_SP, C_sp = GEMMINI_TILE_C_SP;
+    uint64_t t0, t1, t2, t3, t4, t5;
+
+    gemmini_fence();
+    t0 = read_csr_mcycle();
+    gemmini_tile_config();
+    gemmini_fence();
+    t1 = read_csr_mcycle();
+    gemmini_mvin(A, A_sp);
+    gemmini_mvin(B, B_sp);
+    gemmini_fence();
+    t2 = read_csr_mcycle();
+    gemmini_preload_zeros(C_sp);
+    gemmini_compute_preloaded(A_sp, B_sp);
+    gemmini_fence();
+    t3 = read_csr_mcycle();
+    gemmini_mvout(C, C_sp);
+    gemmini_fence();
+    t4 = read_csr_mcycle();
+    gemmini_fence();
+    t5 = read_csr_mcycle();
+
+    ph->setup = t1 - t0;
+    ph->mvin = t2 - t1;
+    ph->compute = t3 - t2;
+    ph->mvout = t4 - t3;
+    ph->fence = t5 - t4;
+}
+
+// ============================================================================
+// Gemmini Tiled Matmul (matrices larger than one DIM x DIM tile)
+// ============================================================================
+
+// Accumulator address flags (top bits of a Gemmini local address)
+#define GEMMINI_ACC_ADDR  (1U << (ADDR_LEN - 1))  // Target the accumulator SRAM
+#define GEMMINI_ACC_ACCUM (1U << (ADDR_LEN - 2))  // Accumulate instead of overwrite
+#define GEMMINI_ACC_FULL  (1U << (ADDR_LEN - 3))  // mvout raw acc_t rows (no scale/act)
+
+#define GEMMINI_SP_ROWS (BANK_NUM * BANK_ROWS)
+
+// DRAM traffic issued by the tiled kernels since the last reset. Each hart
+// counts into its own cache line (only hart 0 without -DMULTI_HART), so
+// Gemmini harts running concurrently never update a shared counter; read
+// the sum with gemmini_traffic_total() after they have joined.
+typedef struct {
+    uint64_t mvin_bytes;
+    uint64_t mvout_bytes;
+} __attribute__((aligned(64))) gemmini_traffic_t;
+
+#ifndef BENCH_MAX_HARTS
+#define BENCH_MAX_HARTS 8
+#endif
+
+static gemmini_traffic_t gemmini_traffic[BENCH_MAX_HARTS];
+
+static inline gemmini_traffic_t* gemmini_traffic_self(void) {
+#ifdef MULTI_HART
+    return &gemmini_traffic[read_csr_mhartid() % BENCH_MAX_HARTS];
+#else
+    return &gemmini_traffic[0];
+#endif
+}
+
+static inline void gemmini_traffic_reset(void) {
+    memset(gemmini_traffic, 0, sizeof(gemmini_traffic));
+}
+
+static inline gemmini_traffic_t gemmini_traffic_total(void) {
+    gemmini_traffic_t sum = { 0, 0 };
+    for (size_t h = 0; h < BENCH_MAX_HARTS; h++) {
+        sum.mvin_bytes += gemmini_traffic[h].mvin_bytes;
+        sum.mvout_bytes += gemmini_traffic[h].mvout_bytes;
+    }
+    return sum;
+}
+
+static inline void gemmini_mvin_counted(const elem_t* src, uint32_t sp, size_t cols, size_t rows) {
+    gemmini_extended_mvin(src, sp, cols, rows);
+    gemmini_traffic_self()->mvin_bytes += cols * rows * sizeof(elem_t);
+}
+
+static inline void gemmini_mvout_counted(void* dst, uint32_t addr, size_t cols, size_t rows,
+                                         size_t elem_bytes) {
+    gemmini_extended_mvout(dst, addr, cols, rows);
+    gemmini_traffic_self()->mvout_bytes += cols * rows * elem_bytes;
+}
+
+// Accumulator-to-output conversion applied by the mvout of C. With
+// full = 0 each INT32 sum is scaled by `scale` (ACC_SCALE rounding), passed
+// through `act` (NO_ACTIVATION or RELU) and saturated to elem_t. With
+// full = 1 the raw acc_t sums are written and scale/act are ignored.
+typedef struct {
+    acc_scale_t scale;
+    int act;
+    int full;
+} gemmini_out_cfg_t;
+
+static const gemmini_out_cfg_t gemmini_out_default = { ACC_SCALE_IDENTITY, NO_ACTIVATION, 0 };
+
+// Order in which the OS kernel visits the C blocks
+typedef enum {
+    GEMMINI_ORDER_IJ,  // Along block rows: one A block row at a time (default)
+    GEMMINI_ORDER_JI,  // Along block columns: one B block column at a time
+} gemmini_order_t;
+
+// Block sizes in units of DIM x DIM tiles. One block of A (tile_i x tile_k)
+// and B (tile_k x tile_j) lives in the scratchpad, and the tile_i x tile_j
+// block of C lives in the accumulator while K is swept.
+typedef struct {
+    size_t tile_i;
+    size_t tile_j;
+    size_t tile_k;
+    gemmini_order_t order;
+} gemmini_tile_cfg_t;
+
+// Schedules for the tiled GEMM
+typedef enum {
+    GEMMINI_SCHED_SERIAL,         // Fence after every K step and every mvout block
+    GEMMINI_SCHED_SINGLE_BUFFER,  // One fence at the end, scratchpad rows reused
+    GEMMINI_SCHED_DOUBLE_BUFFER,  // Ping-pong scratchpad/accumulator halves
+} gemmini_sched_t;
+
+// banks = 2 halves the usable scratchpad and accumulator for ping-ponging
+static inline int gemmini_tile_cfg_fits(const gemmini_tile_cfg_t* cfg, size_t banks) {
+    size_t sp_rows = (cfg->tile_i * cfg->tile_k + cfg->tile_k * cfg->tile_j) * DIM;
+    size_t acc_rows = cfg->tile_i * cfg->tile_j * DIM;
+    return cfg->tile_i > 0 && cfg->tile_j > 0 && cfg->tile_k > 0 &&
+           sp_rows * banks <= GEMMINI_SP_ROWS && acc_rows * banks <= ACC_ROWS;
+}
+
+// Pick a block shape for an MxK * KxN problem: up to 4x4 output tiles per
+// block, then as much of K as one scratchpad bank holds.
+static inline gemmini_tile_cfg_t gemmini_default_tile_cfg(size_t M, size_t N, size_t K,
+                                                         size_t banks) {
+    gemmini_tile_cfg_t cfg;
+    cfg.tile_i = MIN(CEIL_DIV(M, DIM), 4);
+    cfg.tile_j = MIN(CEIL_DIV(N, DIM), 4);
+    while (cfg.tile_i * cfg.tile_j * DIM * banks > ACC_ROWS) {
+        if (cfg.tile_i >= cfg.tile_j) cfg.tile_i--;
+        else cfg.tile_j--;
+    }
+    cfg.tile_k = MIN(CEIL_DIV(K, DIM),
+                     GEMMINI_SP_ROWS / banks / ((cfg.tile_i + cfg.tile_j) * DIM));
+    cfg.order = GEMMINI_ORDER_IJ;
+    return cfg;
+}
+
+// Tiled output-stationary GEMM: C = out(A * B) for row-major INT8 operands
+// (A is MxK, B is KxN, C is MxN, elem_t or acc_t per `out`). Partial sums
+// over K tiles are accumulated in the accumulator and converted on mvout.
+// Edge tiles use the extended commands so M, N and K need not be multiples
+// of DIM. cfg->order picks whether the C blocks are swept along rows or
+// columns.
+//
+// With GEMMINI_SCHED_DOUBLE_BUFFER the A/B blocks alternate between the two
+// scratchpad halves and the C blocks between the two accumulator halves, so
+// the mvin of step i+1 and the mvout of block i-1 carry no address
+// dependency on the compute of step i and Gemmini's ROB can overlap them.
+//
+// The _issue form only queues the RoCC commands, so the host can do other
+// work before its own gemmini_fence(); _ex fences before returning.
+// _issue_ld takes explicit leading dimensions in elements (ldc in elements
+// of the output type); the other forms assume packed operands.
+// Returns 0 on success, -1 if the block shape does not fit on-chip.
+static inline int gemmini_tiled_matmul_os_issue_ld(const elem_t* A, size_t lda,
+                                                   const elem_t* B, size_t ldb,
+                                                   void* C, size_t ldc,
+                                                   size_t M, size_t N, size_t K,
+                                                   const gemmini_tile_cfg_t* cfg,
+                                                   gemmini_sched_t sched,
+                                                   const gemmini_out_cfg_t* out) {
+    const size_t out_bytes = out->full ? sizeof(acc_t) : sizeof(elem_t);
+    const uint32_t out_flags = out->full ? GEMMINI_ACC_FULL : 0;
+    const size_t banks = (sched == GEMMINI_SCHED_DOUBLE_BUFFER) ? 2 : 1;
+    const int serial = (sched == GEMMINI_SCHED_SERIAL);
+    if (!gemmini_tile_cfg_fits(cfg, banks)) {
+        return -1;
+    }
+
+    const size_t I = CEIL_DIV(M, DIM), J = CEIL_DIV(N, DIM), Kt = CEIL_DIV(K, DIM);
+    const uint32_t sp_bank_rows = GEMMINI_SP_ROWS / banks;
+    const uint32_t acc_bank_rows = ACC_ROWS / banks;
+    size_t sp_bank = 0, acc_bank = 0;
+
+    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
+    gemmini_extended_config_st(ldc * out_bytes, out->full ? NO_ACTIVATION : out->act, out->scale);
+
+    // Outer and inner block loops; GEMMINI_ORDER_JI swaps i and j
+    const int ji = (cfg->order == GEMMINI_ORDER_JI);
+    const size_t outer = ji ? J : I, outer_step = ji ? cfg->tile_j : cfg->tile_i;
+    const size_t inner = ji ? I : J, inner_step = ji ? cfg->tile_i : cfg->tile_j;
+
+    for (size_t o0 = 0; o0 < outer; o0 += outer_step) {
+        for (size_t n0 = 0; n0 < inner; n0 += inner_step) {
+            const size_t i0 = ji ? n0 : o0, j0 = ji ? o0 : n0;
+            const size_t bi = MIN(cfg->tile_i, I - i0);
+            const size_t bj = MIN(cfg->tile_j, J - j0);
+            const uint32_t C_acc_base = GEMMINI_ACC_ADDR + acc_bank * acc_bank_rows;
+
+            for (size_t k0 = 0; k0 < Kt; k0 += cfg->tile_k) {
+                const size_t bk = MIN(cfg->tile_k, Kt - k0);
+                const uint32_t A_sp_base = sp_bank * sp_bank_rows;
+                const uint32_t B_sp_base = A_sp_base + cfg->tile_i * cfg->tile_k * DIM;
+
+                // Move in the A block (bi x bk tiles)
+                gemmini_config_ld(lda * sizeof(elem_t));
+                for (size_t i = 0; i < bi; i++) {
+                    const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                    for (size_t k = 0; k < bk; k++) {
+                        const size_t cols = MIN(DIM, K - (k0 + k) * DIM);
+                        const elem_t* src = A + (i0 + i) * DIM * lda + (k0 + k) * DIM;
+                        gemmini_mvin_counted(src, A_sp_base + (i * cfg->tile_k + k) * DIM,
+                                             cols, rows);
+                    }
+                }
+
+                // Move in the B block (bk x bj tiles)
+                gemmini_config_ld(ldb * sizeof(elem_t));
+                for (size_t k = 0; k < bk; k++) {
+                    const size_t rows = MIN(DIM, K - (k0 + k) * DIM);
+                    for (size_t j = 0; j < bj; j++) {
+                        const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                        const elem_t* src = B + (k0 + k) * DIM * ldb + (j0 + j) * DIM;
+                        gemmini_mvin_counted(src, B_sp_base + (k * cfg->tile_j + j) * DIM,
+                                             cols, rows);
+                    }
+                }
+
+                // Compute every output tile of the block against this K slice
+                for (size_t i = 0; i < bi; i++) {
+                    const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                    for (size_t j = 0; j < bj; j++) {
+                        const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                        uint32_t C_acc = C_acc_base + (i * cfg->tile_j + j) * DIM;
+                        for (size_t k = 0; k < bk; k++) {
+                            const size_t depth = MIN(DIM, K - (k0 + k) * DIM);
+                            uint32_t out = (k0 + k == 0) ? C_acc : (C_acc | GEMMINI_ACC_ACCUM);
+                            gemmini_extended_preload(GARBAGE_ADDR, out, DIM, DIM, cols, rows);
+                            gemmini_extended_compute_preloaded(
+                                A_sp_base + (i * cfg->tile_k + k) * DIM,
+                                B_sp_base + (k * cfg->tile_j + j) * DIM,
+                                depth, rows, cols, depth);
+                        }
+                    }
+                }
+
+                if (serial) gemmini_fence();
+                sp_bank = (sp_bank + 1) % banks;
+            }
+
+            // Move out the finished C block through the output conversion
+            for (size_t i = 0; i < bi; i++) {
+                const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                for (size_t j = 0; j < bj; j++) {
+                    const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                    char* dst = (char*)C + ((i0 + i) * DIM * ldc + (j0 + j) * DIM) * out_bytes;
+                    gemmini_mvout_counted(dst,
+                                          (C_acc_base + (i * cfg->tile_j + j) * DIM) | out_flags,
+                                          cols, rows, out_bytes);
+                }
+            }
+
+            if (serial) gemmini_fence();
+            acc_bank = (acc_bank + 1) % banks;
+        }
+    }
+
+    return 0;
+}
+
+static inline int gemmini_tiled_matmul_os_issue(const elem_t* A, const elem_t* B, void* C,
+                                                size_t M, size_t N, size_t K,
+                                                const gemmini_tile_cfg_t* cfg,
+                                                gemmini_sched_t sched,
+                                                const gemmini_out_cfg_t* out) {
+    return gemmini_tiled_matmul_os_issue_ld(A, K, B, N, C, N, M, N, K, cfg, sched, out);
+}
+
+static inline int gemmini_tiled_matmul_os_ex(const elem_t* A, const elem_t* B, void* C,
+                                             size_t M, size_t N, size_t K,
+                                             const gemmini_tile_cfg_t* cfg,
+                                             gemmini_sched_t sched,
+                                             const gemmini_out_cfg_t* out) {
+    int rc = gemmini_tiled_matmul_os_issue(A, B, C, M, N, K, cfg, sched, out);
+    gemmini_fence();
+    return rc;
+}
+
+static inline int gemmini_tiled_matmul_os_sched(const elem_t* A, const elem_t* B, elem_t* C,
+                                                size_t M, size_t N, size_t K,
+                                                const gemmini_tile_cfg_t* cfg,
+                                                gemmini_sched_t sched) {
+    return gemmini_tiled_matmul_os_ex(A, B, C, M, N, K, cfg, sched, &gemmini_out_default);
+}
+
+static inline int gemmini_tiled_matmul_os(const elem_t* A, const elem_t* B, elem_t* C,
+                                          size_t M, size_t N, size_t K,
+                                          const gemmini_tile_cfg_t* cfg) {
+    return gemmini_tiled_matmul_os_sched(A, B, C, M, N, K, cfg, GEMMINI_SCHED_SINGLE_BUFFER);
+}
+
+// Tiled OS GEMM for a resolved gemm_layout_t. Gemmini moves in B rows as
+// stored, so a transposed B is first packed into `b_packed` (l->k * l->n
+// elements) on the host. Returns -1 if that buffer is missing or the block
+// shape does not fit.
+static inline int gemmini_tiled_matmul_layout(const gemm_layout_t* l, const elem_t* A,
+                                              const elem_t* B, void* C, elem_t* b_packed,
+                                              const gemmini_tile_cfg_t* cfg,
+                                              gemmini_sched_t sched,
+                                              const gemmini_out_cfg_t* out) {
+    size_t ldb = l->ldb;
+    if (l->trans_b) {
+        if (!b_packed) return -1;
+        gemm_layout_pack_b(l, B, b_packed);
+        B = b_packed;
+        ldb = l->n;
+    }
+    int rc = gemmini_tiled_matmul_os_issue_ld(A, l->lda, B, ldb, C, l->ldc,
+                                              l->m, l->n, l->k, cfg, sched, out);
+    gemmini_fence();
+    return rc;
+}
+
+// Tiled weight-stationary GEMM, same operands and result as the OS kernel.
+// Blocks are visited column-major (j outer, i inner) so the B block is the
+// resident operand: when one block covers all of K it is moved in once per
+// block column and reused by every A block, instead of once per (i, j)
+// block as in the OS kernel. Inside a block each B tile is preloaded into
+// the array once and the bi A tiles of that K slice stream through it with
+// compute_accumulated. Returns 0 on success, -1 if the block does not fit.
+static inline int gemmini_tiled_matmul_ws(const elem_t* A, const elem_t* B, elem_t* C,
+                                          size_t M, size_t N, size_t K,
+                                          const gemmini_tile_cfg_t* cfg) {
+    if (!gemmini_tile_cfg_fits(cfg, 1)) {
+        return -1;
+    }
+
+    const size_t I = CEIL_DIV(M, DIM), J = CEIL_DIV(N, DIM), Kt = CEIL_DIV(K, DIM);
+    const uint32_t B_sp_base = 0;
+    const uint32_t A_sp_base = cfg->tile_k * cfg->tile_j * DIM;
+    const int b_resident = (cfg->tile_k >= Kt);
+
+    gemmini_config_ex(WEIGHT_STATIONARY, 0, 0);
+    gemmini_config_st(N * sizeof(elem_t));
+
+    for (size_t j0 = 0; j0 < J; j0 += cfg->tile_j) {
+        const size_t bj = MIN(cfg->tile_j, J - j0);
+        for (size_t i0 = 0; i0 < I; i0 += cfg->tile_i) {
+            const size_t bi = MIN(cfg->tile_i, I - i0);
+
+            for (size_t k0 = 0; k0 < Kt; k0 += cfg->tile_k) {
+                const size_t bk = MIN(cfg->tile_k, Kt - k0);
+
+                // Move in the B block (bk x bj tiles) unless it is still resident
+                if (!b_resident || i0 == 0) {
+                    gemmini_config_ld(N * sizeof(elem_t));
+                    for (size_t k = 0; k < bk; k++) {
+                        const size_t rows = MIN(DIM, K - (k0 + k) * DIM);
+                        for (size_t j = 0; j < bj; j++) {
+                            const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                            const elem_t* src = B + (k0 + k) * DIM * N + (j0 + j) * DIM;
+                            gemmini_mvin_counted(src, B_sp_base + (k * cfg->tile_j + j) * DIM,
+                                                 cols, rows);
+                        }
+                    }
+                }
+
+                // Move in the A block (bi x bk tiles)
+                gemmini_config_ld(K * sizeof(elem_t));
+                for (size_t i = 0; i < bi; i++) {
+                    const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                    for (size_t k = 0; k < bk; k++) {
+                        const size_t cols = MIN(DIM, K - (k0 + k) * DIM);
+                        const elem_t* src = A + (i0 + i) * DIM * K + (k0 + k) * DIM;
+                        gemmini_mvin_counted(src, A_sp_base + (i * cfg->tile_k + k) * DIM,
+                                             cols, rows);
+                    }
+                }
+
+                // Preload each B tile once, then stream the A tiles through it
+                for (size_t k = 0; k < bk; k++) {
+                    const size_t depth = MIN(DIM, K - (k0 + k) * DIM);
+                    for (size_t j = 0; j < bj; j++) {
+                        const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                        for (size_t i = 0; i < bi; i++) {
+                            const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                            uint32_t C_acc = GEMMINI_ACC_ADDR + (i * cfg->tile_j + j) * DIM;
+                            uint32_t out = (k0 + k == 0) ? C_acc : (C_acc | GEMMINI_ACC_ACCUM);
+                            uint32_t weights = (i == 0) ? B_sp_base + (k * cfg->tile_j + j) * DIM
+                                                        : GARBAGE_ADDR;
+                            uint32_t a_sp = A_sp_base + (i * cfg->tile_k + k) * DIM;
+                            gemmini_extended_preload(weights, out, cols, depth, cols, rows);
+                            if (i == 0) {
+                                gemmini_extended_compute_preloaded(a_sp, GARBAGE_ADDR,
+                                                                   depth, rows, DIM, DIM);
+                            } else {
+                                gemmini_extended_compute_accumulated(a_sp, GARBAGE_ADDR,
+                                                                     depth, rows, DIM, DIM);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Move out the finished C block, scaled and saturated to INT8
+            for (size_t i = 0; i < bi; i++) {
+                const size_t rows = MIN(DIM, M - (i0 + i) * DIM);
+                for (size_t j = 0; j < bj; j++) {
+                    const size_t cols = MIN(DIM, N - (j0 + j) * DIM);
+                    elem_t* dst = C + (i0 + i) * DIM * N + (j0 + j) * DIM;
+                    gemmini_mvout_counted(dst, GEMMINI_ACC_ADDR + (i * cfg->tile_j + j) * DIM,
+                                          cols, rows, sizeof(elem_t));
+                }
+            }
+        }
+    }
+
+    gemmini_fence();
+    return 0;
+}
+
+// ============================================================================
+// Gemmini Tuned Schedules (loaded from a per-config table)
+// ============================================================================
+
+// Everything the tiled drivers need to run one GEMM shape: dataflow
+// (OUTPUT_STATIONARY or WEIGHT_STATIONARY), the OS schedule and the block
+// shape. The WS kernel always sweeps block columns and ignores sched and
+// cfg.order.
+typedef struct {
+    gemmini_tile_cfg_t cfg;
+    int dataflow;
+    gemmini_sched_t sched;
+} gemmini_schedule_t;
+
+// Scratchpad/accumulator banks a schedule splits its capacity into
+static inline size_t gemmini_schedule_banks(const gemmini_schedule_t* s) {
+    return (s->dataflow == OUTPUT_STATIONARY && s->sched == GEMMINI_SCHED_DOUBLE_BUFFER) ? 2 : 1;
+}
+
+static inline int gemmini_schedule_fits(const gemmini_schedule_t* s) {
+    return gemmini_tile_cfg_fits(&s->cfg, gemmini_schedule_banks(s));
+}
+
+// The default: OS, single buffer, gemmini_default_tile_cfg() blocks
+static inline gemmini_schedule_t gemmini_default_schedule(size_t M, size_t N, size_t K) {
+    gemmini_schedule_t s;
+    s.cfg = gemmini_default_tile_cfg(M, N, K, 1);
+    s.dataflow = OUTPUT_STATIONARY;
+    s.sched = GEMMINI_SCHED_SINGLE_BUFFER;
+    return s;
+}
+
+// C = A * B (packed INT8) with a schedule; returns -1 if it does not fit
+static inline int gemmini_tiled_matmul_schedule(const elem_t* A, const elem_t* B, elem_t* C,
+                                                size_t M, size_t N, size_t K,
+                                                const gemmini_schedule_t* s) {
+    if (s->dataflow == WEIGHT_STATIONARY) {
+        return gemmini_tiled_matmul_ws(A, B, C, M, N, K, &s->cfg);
+    }
+    return gemmini_tiled_matmul_os_sched(A, B, C, M, N, K, &s->cfg, s->sched);
+}
+
+// Tuned table: -DGEMMINI_TUNED_TABLE='"tuned/<Config>.h"' includes the
+// table printed by the tuner (bench_tune.h), one line per shape:
+//   GEMMINI_TUNED_ENTRY(M, N, K, DIM, tile_i, tile_j, tile_k, order, dataflow, sched)
+typedef struct {
+    size_t m, n, k;
+    size_t dim;  // DIM the entry was tuned for
+    gemmini_schedule_t s;
+} gemmini_tuned_t;
+
+#define GEMMINI_TUNED_ENTRY(m, n, k, dim, ti, tj, tk, order, dataflow, sched) \
+    { (m), (n), (k), (dim), { { (ti), (tj), (tk), (order) }, (dataflow), (sched) } },
+
+static const gemmini_tuned_t gemmini_tuned[] = {
+#ifdef GEMMINI_TUNED_TABLE
+#include GEMMINI_TUNED_TABLE
+#endif
+    { 0, 0, 0, 0, { { 0, 0, 0, GEMMINI_ORDER_IJ }, OUTPUT_STATIONARY, GEMMINI_SCHED_SINGLE_BUFFER } },
+};
+
+// Schedule for an M x N x K GEMM: the table entry for this shape when it
+// was tuned for this DIM and fits this config's scratchpad and
+// accumulator, else the default. Returns 1 if the table entry was used.
+static inline int gemmini_tuned_schedule(size_t M, size_t N, size_t K, gemmini_schedule_t* s) {
+    for (const gemmini_tuned_t* t = gemmini_tuned; t->m; t++) {
+        if (t->m == M && t->n == N && t->k == K && t->dim == DIM && gemmini_schedule_fits(&t->s)) {
+            *s = t->s;
+            return 1;
+        }
+    }
+    *s = gemmini_default_schedule(M, N, K);
+    return 0;
+}
+
+// ============================================================================
+// Gemmini Asynchronous Submission (tickets instead of fences)
+// ============================================================================
+
+// A ticket completes when Gemmini writes a sentinel row to memory. The
+// sentinel is an mvin of a fixed pattern into a scratchpad row and an mvout
+// of that row, queued behind the batch it tracks. Other kernels are free to
+// overwrite the row, so every ticket loads the pattern again. The store
+// controller runs mvouts in queue order, so when the pattern shows up in
+// the ticket's slot every earlier mvout of the batch has been issued ahead
+// of it (the DMA writer keeps one request stream, so on the default memory
+// system they have also landed). The host polls the slot with ordinary loads, since
+// Gemmini's DMA is coherent with the L1 D$, and is free until then.
+// gemmini_fence() remains the fallback when that ordering is in doubt.
+
+#define GEMMINI_SENTINEL_SP_ROW (GEMMINI_SP_ROWS - 1)  // Kept free by async GEMMs
+#define GEMMINI_SENTINEL_BYTE   ((elem_t)0x5A)
+
+// Tickets that can be outstanding at once (one memory slot each)
+#ifndef GEMMINI_MAX_TICKETS
+#define GEMMINI_MAX_TICKETS 8
+#endif
+
+typedef struct {
+    volatile elem_t* slot;  // DIM bytes the sentinel lands in; NULL = nothing queued
+    uint64_t submitted;     // mcycle when the sentinel was queued
+} gemmini_ticket_t;
+
+static elem_t gemmini_ticket_slots[GEMMINI_MAX_TICKETS][DIM] __attribute__((aligned(64)));
+static size_t gemmini_ticket_next = 0;
+static elem_t gemmini_sentinel_pattern[DIM] __attribute__((aligned(64)));
+static int gemmini_async_ready = 0;
+
+// Fill the host copy of the sentinel pattern (once)
+static inline void gemmini_async_init(void) {
+    if (gemmini_async_ready) return;
+    memset(gemmini_sentinel_pattern, (uint8_t)GEMMINI_SENTINEL_BYTE,
+           sizeof(gemmini_sentinel_pattern));
+    gemmini_async_ready = 1;
+}
+
+// Close the batch issued so far: clear the next slot, then queue the
+// pattern's mvin and the sentinel mvout behind the batch's commands. Both
+// move a single row, so the current config_ld/config_st strides do not
+// matter, and Gemmini orders the mvout after the mvin of the same row.
+static inline void gemmini_ticket_submit(gemmini_ticket_t* t) {
+    elem_t* slot = gemmini_ticket_slots[gemmini_ticket_next];
+    gemmini_ticket_next = (gemmini_ticket_next + 1) % GEMMINI_MAX_TICKETS;
+
+    gemmini_async_init();
+    memset(slot, 0, DIM * sizeof(elem_t));
+    asm volatile("fence" ::: "memory");  // Clear lands before Gemmini's write
+    gemmini_extended_mvin(gemmini_sentinel_pattern, GEMMINI_SENTINEL_SP_ROW, DIM, 1);
+    gemmini_extended_mvout(slot, GEMMINI_SENTINEL_SP_ROW, DIM, 1);
+
+    t->slot = slot;
+    t->submitted = read_csr_mcycle();
+}
+
+// Non-blocking: 1 once every command before the ticket has completed (at
+// once for a ticket that was never queued)
+static inline int gemmini_ticket_done(const gemmini_ticket_t* t) {
+    if (!t->slot) return 1;
+    if (t->slot[0] != GEMMINI_SENTINEL_BYTE || t->slot[DIM - 1] != GEMMINI_SENTINEL_BYTE) {
+        return 0;
+    }
+    asm volatile("fence r, rw" ::: "memory");  // Later reads of C see the batch
+    return 1;
+}
+
+static inline void gemmini_ticket_wait(const gemmini_ticket_t* t) {
+    while (!gemmini_ticket_done(t)) { }
+}
+
+// gemmini_tile_cfg_fits() minus the sentinel's scratchpad row, so the
+// ticket's mvin never waits on the GEMM's last reads of that row
+static inline int gemmini_async_cfg_fits(const gemmini_tile_cfg_t* cfg, size_t banks) {
+    const size_t sp_rows = (cfg->tile_i * cfg->tile_k + cfg->tile_k * cfg->tile_j) * DIM;
+    return gemmini_tile_cfg_fits(cfg, banks) &&
+           (banks - 1) * (GEMMINI_SP_ROWS / banks) + sp_rows <= GEMMINI_SENTINEL_SP_ROW;
+}
+
+// gemmini_default_tile_cfg() with tile_k shortened until the block leaves
+// the sentinel row alone
+static inline gemmini_tile_cfg_t gemmini_async_tile_cfg(size_t M, size_t N, size_t K, size_t banks) {
+    gemmini_tile_cfg_t cfg = gemmini_default_tile_cfg(M, N, K, banks);
+    while (cfg.tile_k > 1 && !gemmini_async_cfg_fits(&cfg, banks)) cfg.tile_k--;
+    return cfg;
+}
+
+// Queue a tiled OS GEMM and close it with a ticket; returns without waiting.
+// Returns -1 (nothing queued, *t left done) if the block shape does not
+// fit, including the scratchpad row kept for the sentinel.
+static inline int gemmini_tiled_matmul_os_submit(const elem_t* A, const elem_t* B, void* C,
+                                                 size_t M, size_t N, size_t K,
+                                                 const gemmini_tile_cfg_t* cfg,
+                                                 gemmini_sched_t sched,
+                                                 const gemmini_out_cfg_t* out,
+                                                 gemmini_ticket_t* t) {
+    const size_t banks = (sched == GEMMINI_SCHED_DOUBLE_BUFFER) ? 2 : 1;
+    t->slot = NULL;
+    t->submitted = 0;
+    if (!gemmini_async_cfg_fits(cfg, banks)) {
+        return -1;
+    }
+
+    int rc = gemmini_tiled_matmul_os_issue(A, B, C, M, N, K, cfg, sched, out);
+    gemmini_ticket_submit(t);
+    return rc;
+}
+
+// ============================================================================
+// Gemmini Batched Small GEMMs
+// ============================================================================
+
+// Scratchpad/accumulator slots the batch rotates through, so problem b+1's
+// mvin carries no dependency on problem b's compute or mvout
+#ifndef GEMMINI_BATCH_SLOTS
+#define GEMMINI_BATCH_SLOTS 4
+#endif
+
+// A batch of independent small GEMMs C_b = A_b * B_b, every problem with the
+// shape and layout of `l` (m, n, k <= DIM, B not transposed) and stored back
+// to back: problem b starts at A + b * gemm_layout_a_elems(l), and likewise
+// for B and C. The configuration is issued once for the whole batch and the
+// host fences once at the end. A and B share one mvin stride, so l->lda must
+// equal l->ldb; pad the narrower operand's rows up to it.
+// Returns 0, or -1 (nothing issued) if the layout does not qualify.
+static inline int gemmini_matmul_batch(const gemm_layout_t* l, const elem_t* A, const elem_t* B,
+                                       elem_t* C, size_t batch) {
+    if (l->m > DIM || l->n > DIM || l->k > DIM || l->trans_b || l->lda != l->ldb) {
+        return -1;
+    }
+    const size_t a_elems = gemm_layout_a_elems(l);
+    const size_t b_elems = gemm_layout_b_elems(l);
+    const size_t c_elems = gemm_layout_c_elems(l);
+
+    gemmini_config_ld(l->lda * sizeof(elem_t));
+    gemmini_config_st(l->ldc * sizeof(elem_t));
+    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
+
+    for (size_t b = 0; b < batch; b++) {
+        const size_t slot = b % GEMMINI_BATCH_SLOTS;
+        const uint32_t A_sp = slot * 2 * DIM, B_sp = A_sp + DIM;
+        const uint32_t C_acc = GEMMINI_ACC_ADDR + slot * DIM;
+
+        gemmini_extended_mvin(A + b * a_elems, A_sp, l->k, l->m);
+        gemmini_extended_mvin(B + b * b_elems, B_sp, l->n, l->k);
+        gemmini_extended_preload(GARBAGE_ADDR, C_acc, DIM, DIM, l->n, l->m);
+        gemmini_extended_compute_preloaded(A_sp, B_sp, l->k, l->m, l->n, l->k);
+        gemmini_extended_mvout(C + b * c_elems, C_acc, l->n, l->m);
+    }
+    gemmini_fence();
+    return 0;
+}
+
+// ============================================================================
+// Memory Bandwidth Micro-Kernels
+// ============================================================================
+
+// Gemmini DMA only: `rows` DIM-byte rows moved into consecutive scratchpad
+// rows from a source whose rows are `stride` bytes apart, one mvin per DIM
+// rows, then a fence
+static inline void gemmini_mvin_stream(const elem_t* src, size_t rows, size_t stride) {
+    gemmini_config_ld(stride);
+    for (size_t r = 0; r < rows; r += DIM) {
+        gemmini_extended_mvin(src + r * stride, (uint32_t)r, DIM, MIN(DIM, rows - r));
+    }
+    gemmini_fence();
+}
+
+// Gemmini DMA only: `rows` accumulator rows scaled to INT8 and written
+// `stride` bytes apart
+static inline void gemmini_mvout_stream(elem_t* dst, size_t rows, size_t stride) {
+    gemmini_config_st(stride);
+    for (size_t r = 0; r < rows; r += DIM) {
+        gemmini_extended_mvout(dst + r * stride, GEMMINI_ACC_ADDR + (uint32_t)r,
+                               DIM, MIN(DIM, rows - r));
+    }
+    gemmini_fence();
+}
+
+// Ara streaming loads of n INT32 elements `stride` elements apart (1 =
+// unit-stride vle32, otherwise vlse32); data is discarded. e32/m8 in v8.
+static inline void ara_stream_load(const int32_t* src, size_t n, size_t stride) {
+    const size_t stride_bytes = stride * sizeof(int32_t);
+    while (n > 0) {
+        size_t vl;
+        if (stride == 1) {
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m8, ta, ma\n\t"
+                "vle32.v v8, (%[p])"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [p] "r"(src)
+                : "memory", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15"
+            );
+        } else {
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m8, ta, ma\n\t"
+                "vlse32.v v8, (%[p]), %[s]"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [p] "r"(src), [s] "r"(stride_bytes)
+                : "memory", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15"
+            );
+        }
+        src += vl * stride;
+        n -= vl;
+    }
+}
+
+// Ara streaming stores of n INT32 elements `stride` elements apart (1 =
+// unit-stride vse32, otherwise vsse32); every element is written `value`
+static inline void ara_stream_store(int32_t* dst, size_t n, size_t stride, int32_t value) {
+    const size_t stride_bytes = stride * sizeof(int32_t);
+    while (n > 0) {
+        size_t vl;
+        if (stride == 1) {
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m8, ta, ma\n\t"
+                "vmv.v.x v8, %[v]\n\t"
+                "vse32.v v8, (%[p])"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [p] "r"(dst), [v] "r"(value)
+                : "memory", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15"
+            );
+        } else {
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m8, ta, ma\n\t"
+                "vmv.v.x v8, %[v]\n\t"
+                "vsse32.v v8, (%[p]), %[s]"
+                : [vl] "=&r"(vl)
+                : [avl] "r"(n), [p] "r"(dst), [v] "r"(value), [s] "r"(stride_bytes)
+                : "memory", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15"
+            );
+        }
+        dst += vl * stride;
+        n -= vl;
+    }
+}
+
+// Ara unit-stride copy (load + store per strip), the memcpy roofline
+static inline void ara_stream_copy(int32_t* dst, const int32_t* src, size_t n) {
+    while (n > 0) {
+        size_t vl;
+        asm volatile(
+            "vsetvli %[vl], %[avl], e32, m8, ta, ma\n\t"
+            "vle32.v v8, (%[s])\n\t"
+            "vse32.v v8, (%[d])"
+            : [vl] "=&r"(vl)
+            : [avl] "r"(n), [s] "r"(src), [d] "r"(dst)
+            : "memory", "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15"
+        );
+        src += vl;
+        dst += vl;
+        n -= vl;
+    }
+}
+
+// ============================================================================
+// Direct Convolution (NHWC, batch 1, no im2col)
+// ============================================================================
+
+// Input is H x W x Cin, weights KH x KW x Cin x Cout, output OH x OW x Cout,
+// all row-major with channels innermost
+typedef struct {
+    size_t h, w, cin, cout;
+    size_t kh, kw;
+    size_t stride, pad;
+} conv_shape_t;
+
+static inline size_t conv_out_h(const conv_shape_t* cs) {
+    return (cs->h + 2 * cs->pad - cs->kh) / cs->stride + 1;
+}
+
+static inline size_t conv_out_w(const conv_shape_t* cs) {
+    return (cs->w + 2 * cs->pad - cs->kw) / cs->stride + 1;
+}
+
+static inline uint64_t conv_ops(const conv_shape_t* cs) {
+    return 2ULL * conv_out_h(cs) * conv_out_w(cs) * cs->cout * cs->kh * cs->kw * cs->cin;
+}
+
+// Largest Cin the Ara kernel's zero pixel covers
+#ifndef CONV_MAX_CIN
+#define CONV_MAX_CIN 256
+#endif
+
+// Stands in for padded input pixels so every tap runs the same inner loop
+static const int8_t conv_zero_pixel[CONV_MAX_CIN] __attribute__((aligned(64)));
+
+// Scalar direct convolution, INT8 x INT8 -> INT32 (reference)
+static inline void scalar_conv2d_int8(const conv_shape_t* cs, const int8_t* in, const int8_t* w,
+                                      int32_t* out) {
+    const size_t OH = conv_out_h(cs), OW = conv_out_w(cs);
+    for (size_t oh = 0; oh < OH; oh++) {
+        for (size_t ow = 0; ow < OW; ow++) {
+            for (size_t co = 0; co < cs->cout; co++) {
+                int32_t sum = 0;
+                for (size_t kh = 0; kh < cs->kh; kh++) {
+                    long ih = (long)(oh * cs->stride + kh) - (long)cs->pad;
+                    if (ih < 0 || ih >= (long)cs->h) continue;
+                    for (size_t kw = 0; kw < cs->kw; kw++) {
+                        long iw = (long)(ow * cs->stride + kw) - (long)cs->pad;
+                        if (iw < 0 || iw >= (long)cs->w) continue;
+                        const int8_t* px = in + ((size_t)ih * cs->w + (size_t)iw) * cs->cin;
+                        const int8_t* wt = w + (kh * cs->kw + kw) * cs->cin * cs->cout + co;
+                        for (size_t ci = 0; ci < cs->cin; ci++) {
+                            sum += (int32_t)px[ci] * (int32_t)wt[ci * cs->cout];
+                        }
+                    }
+                }
+                out[(oh * OW + ow) * cs->cout + co] = sum;
+            }
+        }
+    }
+}
+
+// Ara direct convolution, INT8 x INT8 -> INT32. Vectorized over Cout: for
+// ARA_MM_ROWS output pixels at a time, each tap is the widening matmul inner
+// loop with the input pixels' channels as the A rows and the tap's
+// Cin x Cout weight slice as B. Accumulators are reloaded from and stored to
+// `out` around each tap, so no vector state crosses asm blocks. Padded
+// pixels read conv_zero_pixel; remainder pixels alias the last one and
+// store identical sums. Returns -1 if Cin exceeds CONV_MAX_CIN.
+static inline int ara_conv2d_int8(const conv_shape_t* cs, const int8_t* in, const int8_t* w,
+                                  int32_t* out) {
+    const size_t OH = conv_out_h(cs), OW = conv_out_w(cs);
+    const size_t Cin = cs->cin, Cout = cs->cout;
+    if (Cin == 0 || Cin > CONV_MAX_CIN) return -1;
+
+    memset(out, 0, OH * OW * Cout * sizeof(int32_t));
+
+    for (size_t oh = 0; oh < OH; oh++) {
+        for (size_t ow = 0; ow < OW; ow += ARA_MM_ROWS) {
+            size_t pix[ARA_MM_ROWS];
+            for (size_t r = 0; r < ARA_MM_ROWS; r++) pix[r] = MIN(ow + r, OW - 1);
+            int32_t* c0 = out + (oh * OW + pix[0]) * Cout;
+            int32_t* c1 = out + (oh * OW + pix[1]) * Cout;
+            int32_t* c2 = out + (oh * OW + pix[2]) * Cout;
+            int32_t* c3 = out + (oh * OW + pix[3]) * Cout;
+
+            for (size_t kh = 0; kh < cs->kh; kh++) {
+                long ih = (long)(oh * cs->stride + kh) - (long)cs->pad;
+                if (ih < 0 || ih >= (long)cs->h) continue;
+                for (size_t kw = 0; kw < cs->kw; kw++) {
+                    const int8_t* px[ARA_MM_ROWS];
+                    for (size_t r = 0; r < ARA_MM_ROWS; r++) {
+                        long iw = (long)(pix[r] * cs->stride + kw) - (long)cs->pad;
+                        px[r] = (iw < 0 || iw >= (long)cs->w)
+                              ? conv_zero_pixel
+                              : in + ((size_t)ih * cs->w + (size_t)iw) * Cin;
+                    }
+                    const int8_t* wt = w + (kh * cs->kw + kw) * Cin * Cout;
+
+                    for (size_t co = 0; co < Cout; ) {
+                        size_t vl;
+                        size_t k = Cin;
+                        const int8_t* b = wt + co;
+                        const int8_t* p0 = px[0];
+                        const int8_t* p1 = px[1];
+                        const int8_t* p2 = px[2];
+                        const int8_t* p3 = px[3];
+
+                        asm volatile(
+                            "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                            "vle32.v v8, (%[c0])\n\t"
+                            "vle32.v v12, (%[c1])\n\t"
+                            "vle32.v v16, (%[c2])\n\t"
+                            "vle32.v v20, (%[c3])\n\t"
+                            "1:\n\t"
+                            "vle8.v v4, (%[b])\n\t"
+                            "vsext.vf4 v24, v4\n\t"
+                            "lb t0, 0(%[p0])\n\t"
+                            "lb t1, 0(%[p1])\n\t"
+                            "lb t2, 0(%[p2])\n\t"
+                            "lb t3, 0(%[p3])\n\t"
+                            "vmacc.vx v8, t0, v24\n\t"
+                            "vmacc.vx v12, t1, v24\n\t"
+                            "vmacc.vx v16, t2, v24\n\t"
+                            "vmacc.vx v20, t3, v24\n\t"
+                            "add %[b], %[b], %[bstride]\n\t"
+                            "addi %[p0], %[p0], 1\n\t"
+                            "addi %[p1], %[p1], 1\n\t"
+                            "addi %[p2], %[p2], 1\n\t"
+                            "addi %[p3], %[p3], 1\n\t"
+                            "addi %[k], %[k], -1\n\t"
+                            "bnez %[k], 1b\n\t"
+                            "vse32.v v8, (%[c0])\n\t"
+                            "vse32.v v12, (%[c1])\n\t"
+                            "vse32.v v16, (%[c2])\n\t"
+                            "vse32.v v20, (%[c3])"
+                            : [vl] "=&r"(vl), [b] "+r"(b), [k] "+r"(k),
+                              [p0] "+r"(p0), [p1] "+r"(p1), [p2] "+r"(p2), [p3] "+r"(p3)
+                            : [avl] "r"(Cout - co), [bstride] "r"(Cout * sizeof(int8_t)),
+                              [c0] "r"(c0 + co), [c1] "r"(c1 + co),
+                              [c2] "r"(c2 + co), [c3] "r"(c3 + co)
+                            : "t0", "t1", "t2", "t3", "memory", "v4",
+                              "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",
+                              "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",
+                              "v24", "v25", "v26", "v27"
+                        );
+
+                        co += vl;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Input tiles in flight in the scratchpad ring behind the resident weights
+#ifndef CONV_A_SLOTS
+#define CONV_A_SLOTS 8
+#endif
+
+// Gemmini direct convolution, INT8 out via the accumulator scale. The whole
+// weight tensor is moved in once and stays resident. Each tap of each DIM-wide
+// run of output pixels is one GEMM tile: consecutive output pixels read input
+// pixels `stride` apart, so the window is a single strided mvin (row stride
+// stride*Cin) with no im2col buffer. Padded pixels are skipped by shrinking
+// the tile to the valid rows and offsetting its accumulator address. The
+// center tap goes first and, with an odd kernel and pad <= kernel/2, covers
+// every row, so it initialises the accumulator and the other taps
+// accumulate. Output tiles alternate between two accumulator halves.
+// Returns -1 if the weights do not fit on-chip, a kernel size is even or
+// pad > kernel/2.
+static inline int gemmini_conv2d_direct(const conv_shape_t* cs, const elem_t* in, const elem_t* w,
+                                        elem_t* out, acc_scale_t scale) {
+    const size_t OH = conv_out_h(cs), OW = conv_out_w(cs);
+    const size_t Cin = cs->cin, Cout = cs->cout, KW = cs->kw;
+    const size_t taps = cs->kh * KW;
+    const size_t CiT = CEIL_DIV(Cin, DIM), CoT = CEIL_DIV(Cout, DIM);
+    const size_t w_rows = taps * CiT * CoT * DIM;
+    const uint32_t A_base = w_rows;
+    const size_t center = (cs->kh / 2) * KW + KW / 2;
+
+    if (w_rows + CONV_A_SLOTS * DIM > GEMMINI_SP_ROWS || 2 * CoT * DIM > ACC_ROWS ||
+        cs->kh % 2 == 0 || KW % 2 == 0 || cs->pad > cs->kh / 2 || cs->pad > KW / 2) {
+        return -1;
+    }
+
+#define CONV_W_SP(tap, ci_t, co_t) ((((tap) * CiT + (ci_t)) * CoT + (co_t)) * DIM)
+
+    gemmini_config_ex(OUTPUT_STATIONARY, 0, 0);
+    gemmini_extended_config_st(Cout * sizeof(elem_t), NO_ACTIVATION, scale);
+
+    // Weights, resident for the whole layer
+    gemmini_config_ld(Cout * sizeof(elem_t));
+    for (size_t tap = 0; tap < taps; tap++) {
+        for (size_t ci_t = 0; ci_t < CiT; ci_t++) {
+            const size_t rows = MIN(DIM, Cin - ci_t * DIM);
+            for (size_t co_t = 0; co_t < CoT; co_t++) {
+                const size_t cols = MIN(DIM, Cout - co_t * DIM);
+                const elem_t* src = w + (tap * Cin + ci_t * DIM) * Cout + co_t * DIM;
+                gemmini_mvin_counted(src, CONV_W_SP(tap, ci_t, co_t), cols, rows);
+            }
+        }
+    }
+
+    // Input windows
+    gemmini_config_ld(cs->stride * Cin * sizeof(elem_t));
+    size_t slot = 0, acc_bank = 0;
+
+    for (size_t oh = 0; oh < OH; oh++) {
+        for (size_t ow0 = 0; ow0 < OW; ow0 += DIM) {
+            const size_t rows_o = MIN(DIM, OW - ow0);
+            const uint32_t C_base = GEMMINI_ACC_ADDR + acc_bank * CoT * DIM;
+
+            for (size_t t = 0; t < taps; t++) {
+                const size_t tap = (t == 0) ? center : (t <= center ? t - 1 : t);
+                const size_t kh = tap / KW, kw = tap % KW;
+                long ih = (long)(oh * cs->stride + kh) - (long)cs->pad;
+                if (ih < 0 || ih >= (long)cs->h) continue;
+
+                // Output pixels of this run whose input column is in bounds;
+                // a negative span means no output pixel reaches this tap
+                const long span = (long)cs->w - 1 + (long)cs->pad - (long)kw;
+                if (span < 0) continue;
+                long lo = (long)ow0, hi = (long)(ow0 + rows_o);
+                long first = kw >= cs->pad ? 0 : (long)CEIL_DIV(cs->pad - kw, cs->stride);
+                long last = span / (long)cs->stride;
+                if (lo < first) lo = first;
+                if (hi > last + 1) hi = last + 1;
+                if (lo >= hi) continue;
+                const size_t R = (size_t)(hi - lo);
+                const size_t iw = (size_t)lo * cs->stride + kw - cs->pad;
+
+                for (size_t ci_t = 0; ci_t < CiT; ci_t++) {
+                    const size_t depth = MIN(DIM, Cin - ci_t * DIM);
+                    const uint32_t A_sp = A_base + slot * DIM;
+                    slot = (slot + 1) % CONV_A_SLOTS;
+
+                    const elem_t* src = in + ((size_t)ih * cs->w + iw) * Cin + ci_t * DIM;
+                    gemmini_mvin_counted(src, A_sp, depth, R);
+
+                    for (size_t co_t = 0; co_t < CoT; co_t++) {
+                        const size_t cols = MIN(DIM, Cout - co_t * DIM);
+                        uint32_t C_acc = C_base + co_t * DIM + (uint32_t)(lo - (long)ow0);
+                        uint32_t dst = (t == 0 && ci_t == 0) ? C_acc : (C_acc | GEMMINI_ACC_ACCUM);
+                        gemmini_extended_preload(GARBAGE_ADDR, dst, DIM, DIM, cols, R);
+                        gemmini_extended_compute_preloaded(A_sp, CONV_W_SP(tap, ci_t, co_t),
+                                                           depth, R, cols, depth);
+                    }
+                }
+            }
+
+            for (size_t co_t = 0; co_t < CoT; co_t++) {
+                const size_t cols = MIN(DIM, Cout - co_t * DIM);
+                elem_t* dst = out + (oh * OW + ow0) * Cout + co_t * DIM;
+                gemmini_mvout_counted(dst, C_base + co_t * DIM, cols, rows_o, sizeof(elem_t));
+            }
+            acc_bank ^= 1;
+        }
+    }
+
+#undef CONV_W_SP
+
+    gemmini_fence();
+    return 0;
+}
+
+// ============================================================================
+// Sparse Weights (column-compressed INT8, 2:4 or unstructured)
+// ============================================================================
+
+// Pruned K x N weights B stored column-wise for Ara, ELLPACK style: slot s
+// holds the s-th nonzero of every column, so a slot is one unit-stride row
+// of N values plus N k indices. The vector lanes run over columns (as in
+// the dense kernels), which CSR rows of uneven length would not allow.
+// Columns with fewer nonzeros than `slots` are padded with weight 0, so
+// unstructured sparsity pays for its densest column. 2:4 pruning packs to
+// exactly K/2 slots.
+typedef struct {
+    size_t k, n;     // Dense shape of B
+    size_t slots;    // Entries stored per column (the column maximum)
+    size_t nnz;      // True nonzeros
+    int8_t* vals;    // slots x n
+    uint16_t* idx;   // slots x n: k of each entry (its byte offset in an A row)
+} sparse_int8_t;
+
+// Position hash for the pruning masks (murmur3 finalizer)
+static inline uint32_t sparse_hash(size_t pos, uint32_t seed) {
+    uint32_t h = (uint32_t)pos ^ seed;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Kept weights use the init_matrix_int8_rect pattern with 0 mapped to 1,
+// so the stored density is exactly what the mask keeps
+static inline elem_t sparse_weight(size_t pos, uint32_t seed) {
+    const int32_t v = (int32_t)((seed + pos) % 16) - 8;
+    return v ? (elem_t)v : 1;
+}
+
+// Row-major K x N weights, each element kept with probability density_pct
+static inline void init_matrix_int8_sparse(elem_t* mat, size_t rows, size_t cols,
+                                           size_t density_pct, uint32_t seed) {
+    for (size_t i = 0; i < rows * cols; i++) {
+        mat[i] = sparse_hash(i, seed) % 100 < density_pct ? sparse_weight(i, seed) : 0;
+    }
+}
+
+// Row-major K x N weights with 2:4 structure along K: every aligned group
+// of four k keeps two nonzeros per column (rows must be a multiple of 4)
+static inline void init_matrix_int8_2to4(elem_t* mat, size_t rows, size_t cols, uint32_t seed) {
+    for (size_t g = 0; g < rows; g += 4) {
+        for (size_t j = 0; j < cols; j++) {
+            const uint32_t h = sparse_hash(g * cols + j, seed);
+            const size_t first = h % 4, second = (first + 1 + (h / 4) % 3) % 4;
+            for (size_t r = 0; r < 4; r++) {
+                const size_t pos = (g + r) * cols + j;
+                mat[pos] = (r == first || r == second) ? sparse_weight(pos, seed) : 0;
+            }
+        }
+    }
+}
+
+// Compress dense B (K x N, row pitch N) into `sp`, backed by `vals` and
+// `idx` with room for `cap` entries each. Returns -1 if K exceeds the
+// 16-bit indices or the densest column does not fit.
+static inline int sparse_int8_pack(const int8_t* B, size_t K, size_t N, int8_t* vals,
+                                   uint16_t* idx, size_t cap, sparse_int8_t* sp) {
+    size_t slots = 0, nnz = 0;
+    if (K > 65536) return -1;
+    for (size_t j = 0; j < N; j++) {
+        size_t count = 0;
+        for (size_t k = 0; k < K; k++) count += B[k * N + j] != 0;
+        slots = count > slots ? count : slots;
+        nnz += count;
+    }
+    if (slots * N > cap) return -1;
+
+    for (size_t j = 0; j < N; j++) {
+        size_t s = 0;
+        for (size_t k = 0; k < K; k++) {
+            if (B[k * N + j] != 0) {
+                vals[s * N + j] = B[k * N + j];
+                idx[s * N + j] = (uint16_t)k;
+                s++;
+            }
+        }
+        for (; s < slots; s++) {
+            vals[s * N + j] = 0;
+            idx[s * N + j] = 0;
+        }
+    }
+    sp->k = K;
+    sp->n = N;
+    sp->slots = slots;
+    sp->nnz = nnz;
+    sp->vals = vals;
+    sp->idx = idx;
+    return 0;
+}
+
+// C = A * B, INT8 A (M x K, row pitch lda) times sparse INT8 B into INT32
+// C (M x N, packed). Per 4-row strip and column strip, each slot loads the
+// weights (v30) and their k (v28, e16) with unit stride and gathers the
+// matching A bytes of the four rows with vluxei16 (v4-v7), at e8/m1 so vl
+// carries over to the e32/m4 multiply-accumulate. Work scales with slots,
+// not K.
+static inline void ara_vector_matmul_int8_sparse(const int8_t* A, size_t lda, const sparse_int8_t* B,
+                                                 int32_t* C, size_t M) {
+    const size_t N = B->n;
+    if (M == 0 || N == 0) return;
+
+    for (size_t i = 0; i < M; i += ARA_MM_ROWS) {
+        const size_t r1 = MIN(i + 1, M - 1), r2 = MIN(i + 2, M - 1), r3 = MIN(i + 3, M - 1);
+
+        for (size_t j = 0; j < N; ) {
+            size_t vl;
+            size_t s = B->slots;
+            const int8_t* w = B->vals + j;
+            const uint16_t* x = B->idx + j;
+
+            asm volatile(
+                "vsetvli %[vl], %[avl], e32, m4, ta, ma\n\t"
+                "vmv.v.i v8, 0\n\t"
+                "vmv.v.i v12, 0\n\t"
+                "vmv.v.i v16, 0\n\t"
+                "vmv.v.i v20, 0\n\t"
+                "beqz %[s], 2f\n\t"
+                "1:\n\t"
+                "vsetvli zero, zero, e8, m1, ta, ma\n\t"
+                "vle8.v v30, (%[w])\n\t"
+                "vle16.v v28, (%[x])\n\t"
+                "vluxei16.v v4, (%[p0]), v28\n\t"
+                "vluxei16.v v5, (%[p1]), v28\n\t"
+                "vluxei16.v v6, (%[p2]), v28\n\t"
+                "vluxei16.v v7, (%[p3]), v28\n\t"
+                "vsetvli zero, zero, e32, m4, ta, ma\n\t"
+                "vsext.vf4 v0, v30\n\t"
+                "vsext.vf4 v24, v4\n\t"
+                "vmacc.vv v8, v24, v0\n\t"
+                "vsext.vf4 v24, v5\n\t"
+                "vmacc.vv v12, v24, v0\n\t"
+                "vsext.vf4 v24, v6\n\t"
+                "vmacc.vv v16, v24, v0\n\t"
+                "vsext.vf4 v24, v7\n\t"
+                "vmacc.vv v20, v24, v0\n\t"
+                "add %[w], %[w], %[wstep]\n\t"
+                "add %[x], %[x], %[xstep]\n\t"
+                "addi %[s], %[s], -1\n\t"
+                "bnez %[s], 1b\n\t"
+                "2:\n\t"
+                "vse32.v v8, (%[c0])\n\t"
+                "vse32.v v12, (%[c1])\n\t"
+                "vse32.v v16, (%[c2])\n\t"
+                "vse32.v v20, (%[c3])"
+                : [vl] "=&r"(vl), [s] "+r"(s), [w] "+r"(w), [x] "+r"(x)
+                : [avl] "r"(N - j), [wstep] "r"(N * sizeof(int8_t)),
+                  [xstep] "r"(N * sizeof(uint16_t)),
+                  [p0] "r"(A + i * lda), [p1] "r"(A + r1 * lda),
+                  [p2] "r"(A + r2 * lda), [p3] "r"(A + r3 * lda),
+                  [c0] "r"(C + i * N + j), [c1] "r"(C + r1 * N + j),
+                  [c2] "r"(C + r2 * N + j), [c3] "r"(C + r3 * N + j)
+                : "memory", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+                  "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15",
+                  "v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23",
+                  "v24", "v25", "v26", "v27", "v28", "v29", "v30"
+            );
+
+            j += vl;
+        }
+    }
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+// Mismatches printed per check; every mismatch is still counted
+#ifndef VERIFY_MAX_SHOWN
+#define VERIFY_MAX_SHOWN 5
+#endif
+
+// -DVERIFY_STRICT: tolerances are ignored (every check is exact) and each
+// "Verification:" line also prints the max abs error and the checksums of
+// the outputs checked since the previous line
+#ifdef VERIFY_STRICT
+#define VERIFY_TOL(tol) ((void)(tol), 0)  // Still consumes the parameter
+#else
+#define VERIFY_TOL(tol) (tol)
+#endif
+
+// Accumulated by every check below; verify_report() prints and resets it.
+// `failed` is never reset, so main() can fail the run even if a test
+// ignored its own error count.
+typedef struct {
+    uint64_t elems;
+    uint64_t errors;
+    uint64_t max_abs_err;
+    uint64_t checksum_got;  // Order-sensitive hash of the outputs
+    uint64_t checksum_ref;
+    int failed;
+} verify_stats_t;
+
+static verify_stats_t verify_stats;
+
+// Multiply-xor step; the added constant makes runs of zeros count too
+static inline uint64_t verify_hash(uint64_t h, int64_t v) {
+    return (h * 0x100000001B3ULL) ^ ((uint64_t)v + 0x9E3779B97F4A7C15ULL);
+}
+
+// Record one compared element; returns 1 if it counts as a mismatch
+static inline int verify_elem(int64_t got, int64_t ref, int64_t tol) {
+    const int64_t diff = got - ref;
+    const uint64_t abs_diff = (uint64_t)(diff < 0 ? -diff : diff);
+    verify_stats.elems++;
+    verify_stats.checksum_got = verify_hash(verify_stats.checksum_got, got);
+    verify_stats.checksum_ref = verify_hash(verify_stats.checksum_ref, ref);
+    if (abs_diff > verify_stats.max_abs_err) verify_stats.max_abs_err = abs_diff;
+    if (abs_diff > (uint64_t)tol) {
+        verify_stats.errors++;
+        verify_stats.failed = 1;
+        return 1;
+    }
+    return 0;
+}
+
+// Counts INT8 mismatches between two row-major buffers
+static inline int count_mismatches_int8(const elem_t* got, const elem_t* ref, size_t len) {
+    int errors = 0;
+    for (size_t i = 0; i < len; i++) {
+        errors += verify_elem(got[i], ref[i], 0);
+    }
+    return errors;
+}
+
+// Row-major INT32 check; `cols` is only used to print [row][col]
+static inline int verify_int32(const int32_t* got, const int32_t* ref, size_t len, size_t cols) {
+    int errors = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (verify_elem(got[i], ref[i], 0)) {
+            if (errors < VERIFY_MAX_SHOWN) {
+                printf("  MISMATCH at [%zu][%zu]: got %d, expected %d\n",
+                       i / cols, i % cols, got[i], ref[i]);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Row-major INT8 check; differences up to `tol` are accepted (0 under
+// VERIFY_STRICT)
+static inline int verify_int8(const elem_t* got, const elem_t* ref, size_t len, size_t cols,
+                              int tol) {
+    int errors = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (verify_elem(got[i], ref[i], VERIFY_TOL(tol))) {
+            if (errors < VERIFY_MAX_SHOWN) {
+                printf("  MISMATCH at [%zu][%zu]: got %d, expected %d\n",
+                       i / cols, i % cols, (int)got[i], (int)ref[i]);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Floating-point checks compare in units in the last place: bit patterns
+// are mapped to integers that order like the values (+0 and -0 both map to
+// 0), so `ulps` bounds how many representable values apart got and ref may
+// be (0 under VERIFY_STRICT, through VERIFY_TOL like the integer checks).
+// max_abs_err and the checksums then refer to those integers.
+static inline int64_t verify_fp_ordered(uint32_t bits, uint32_t sign) {
+    return (bits & sign) ? -(int64_t)(bits & (sign - 1)) : (int64_t)bits;
+}
+
+static inline int verify_fp32(const float* got, const float* ref, size_t len, size_t cols, int ulps) {
+    int errors = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t g, r;
+        memcpy(&g, &got[i], sizeof(g));
+        memcpy(&r, &ref[i], sizeof(r));
+        if (verify_elem(verify_fp_ordered(g, 0x80000000u), verify_fp_ordered(r, 0x80000000u),
+                        VERIFY_TOL(ulps))) {
+            if (errors < VERIFY_MAX_SHOWN) {
+                printf("  MISMATCH at [%zu][%zu]: got 0x%08x, expected 0x%08x\n",
+                       i / cols, i % cols, (unsigned)g, (unsigned)r);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Same for BF16 outputs, `ulps` in BF16 units
+static inline int verify_bf16(const bf16_t* got, const bf16_t* ref, size_t len, size_t cols,
+                              int ulps) {
+    int errors = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (verify_elem(verify_fp_ordered(got[i], 0x8000u), verify_fp_ordered(ref[i], 0x8000u),
+                        VERIFY_TOL(ulps))) {
+            if (errors < VERIFY_MAX_SHOWN) {
+                printf("  MISMATCH at [%zu][%zu]: got 0x%04x, expected 0x%04x\n",
+                       i / cols, i % cols, (unsigned)got[i], (unsigned)ref[i]);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Reference-free O(M*N + M*K + K*N) check of an INT32 row-major C = A * B:
+// each row sum of C must equal A's row times the row sums of B (C * 1 =
+// A * (B * 1)), in wrapping 32-bit arithmetic like the kernels. Catches
+// any single wrong element; returns the number of bad rows.
+static inline int verify_matmul_rowsums_int32(const int32_t* A, const int32_t* B, const int32_t* C,
+                                              size_t M, size_t N, size_t K) {
+    int errors = 0;
+    for (size_t i = 0; i < M; i++) {
+        uint32_t got = 0, expect = 0;
+        for (size_t j = 0; j < N; j++) got += (uint32_t)C[i * N + j];
+        for (size_t k = 0; k < K; k++) {
+            uint32_t b_row = 0;
+            for (size_t j = 0; j < N; j++) b_row += (uint32_t)B[k * N + j];
+            expect += (uint32_t)A[i * K + k] * b_row;
+        }
+        if (verify_elem((int32_t)got, (int32_t)expect, 0)) {
+            if (errors < VERIFY_MAX_SHOWN) {
+                printf("  MISMATCH in row %zu sum: got %d, expected %d\n",
+                       i, (int32_t)got, (int32_t)expect);
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+// Print the strict stats of the checks since the last report and reset them
+static inline void verify_flush_stats(void) {
+#ifdef VERIFY_STRICT
+    printf("  Checked: %llu elements, %llu mismatches, max abs error %llu\n",
+           (unsigned long long)verify_stats.elems, (unsigned long long)verify_stats.errors,
+           (unsigned long long)verify_stats.max_abs_err);
+    printf("  Checksum: got 0x%016llx, expected 0x%016llx\n",
+           (unsigned long long)verify_stats.checksum_got,
+           (unsigned long long)verify_stats.checksum_ref);
+#endif
+    const int failed = verify_stats.failed;
+    memset(&verify_stats, 0, sizeof(verify_stats));
+    verify_stats.failed = failed;
+}
+
+// Print the "Verification:" line for an error count and reset the
+// accumulated stats; returns 1 on failure
+static inline int verify_report(int errors) {
+    if (errors == 0) {
+        printf("  Verification: PASSED\n");
+    } else {
+        printf("  Verification: FAILED (%d errors)\n", errors);
+        verify_stats.failed = 1;
+    }
+    verify_flush_stats();
+    return errors != 0;
+}
+
+// Same, for tests that keep a pass/fail flag rather than an error count;
+// `scope` names what was checked, e.g. "all schedules"
+static inline int verify_report_result(int result, const char* scope) {
+    if (result == 0) {
+        printf("  Verification: PASSED (%s)\n", scope);
+    } else {
+        printf("  Verification: FAILED (%s)\n", scope);
+        verify_stats.failed = 1;
+    }
+    verify_flush_stats();
+    return result != 0;
+}
+
+// Exit status for main(): non-zero if any test failed or any check found a
+// mismatch, whether or not the test reported it
+static inline int verify_exit_status(int result) {
+    if (verify_stats.failed && result == 0) {
+        printf("  Verification: mismatches were recorded by a test that reported success\n");
+    }
+    return (result != 0 || verify_stats.failed) ? 1 : 0;
+}
+
+#endif // BENCH_KERNELS_H
@@ -0,0 +1,119 @@
+// Page-backed operand arenas for the Linux (non-BAREMETAL) build
+// Gemmini translates every DMA address through its own TLB, so the page
+// size behind A/B/C decides how many misses a large GEMM takes. An arena
+// is one mmap'd region, populated and locked up front; operands are carved
+// out of it so they share the same backing.
+//
+//   bench_arena_t a;
+//   if (bench_arena_init(&a, bytes, BENCH_PAGES_HUGE) == 0) {
+//       elem_t* A = bench_arena_alloc(&a, M * K, 64);
+//       ...
+//       bench_arena_release(&a);
+//   }
+//
+// BENCH_PAGES_HUGE tries hugetlbfs first (needs /proc/sys/vm/nr_hugepages)
+// and falls back to transparent huge pages; `backing` says which one was
+// obtained. BENCH_PAGES_SMALL opts out of THP so it really is 4 KB pages.
+
+#ifndef BENCH_MEM_H
+#define BENCH_MEM_H
+
+#ifndef BAREMETAL
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "bench_kernels.h"
+
+// Huge page size the arenas are rounded to (2 MB on Sv39)
+#ifndef BENCH_HUGE_PAGE_BYTES
+#define BENCH_HUGE_PAGE_BYTES (2UL * 1024 * 1024)
+#endif
+
+typedef enum {
+    BENCH_PAGES_SMALL,
+    BENCH_PAGES_HUGE,
+} bench_pages_t;
+
+typedef struct {
+    uint8_t* base;
+    size_t size;
+    size_t used;
+    const char* backing;  // "4k", "hugetlb" or "thp"
+} bench_arena_t;
+
+static void* bench_mmap(size_t bytes, int extra_flags) {
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | extra_flags, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+// Map, fault in and lock `bytes` (rounded up to whole huge pages). Returns 0
+// on success, -1 if no mapping of the requested kind could be made.
+static int bench_arena_init(bench_arena_t* a, size_t bytes, bench_pages_t pages) {
+    const size_t size = CEIL_DIV(bytes, BENCH_HUGE_PAGE_BYTES) * BENCH_HUGE_PAGE_BYTES;
+    void* p = NULL;
+
+    memset(a, 0, sizeof(*a));
+    if (pages == BENCH_PAGES_HUGE) {
+#ifdef MAP_HUGETLB
+        p = bench_mmap(size, MAP_HUGETLB);
+        a->backing = "hugetlb";
+#endif
+#ifdef MADV_HUGEPAGE
+        if (!p) {
+            // THP only backs huge-page-aligned ranges: overmap and trim
+            uint8_t* raw = (uint8_t*)mmap(NULL, size + BENCH_HUGE_PAGE_BYTES,
+                                          PROT_READ | PROT_WRITE,
+                                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw != MAP_FAILED) {
+                uintptr_t aligned = CEIL_DIV((uintptr_t)raw, BENCH_HUGE_PAGE_BYTES) *
+                                    BENCH_HUGE_PAGE_BYTES;
+                size_t head = aligned - (uintptr_t)raw;
+                if (head) munmap(raw, head);
+                munmap((uint8_t*)aligned + size, BENCH_HUGE_PAGE_BYTES - head);
+                p = (void*)aligned;
+                madvise(p, size, MADV_HUGEPAGE);
+                a->backing = "thp";
+            }
+        }
+#endif
+    } else {
+        p = bench_mmap(size, 0);
+#ifdef MADV_NOHUGEPAGE
+        if (p) madvise(p, size, MADV_NOHUGEPAGE);
+#endif
+        a->backing = "4k";
+    }
+    if (!p) return -1;
+
+    // Touch every byte so faults (and THP collapse) happen before timing
+    memset(p, 0, size);
+    if (mlock(p, size) != 0) {
+        perror("mlock");
+    }
+
+    a->base = (uint8_t*)p;
+    a->size = size;
+    return 0;
+}
+
+// Next `bytes` of the arena at `align` (power of two); NULL when full
+static void* bench_arena_alloc(bench_arena_t* a, size_t bytes, size_t align) {
+    size_t off = (a->used + align - 1) & ~(align - 1);
+    if (off + bytes > a->size) return NULL;
+    a->used = off + bytes;
+    return a->base + off;
+}
+
+static void bench_arena_release(bench_arena_t* a) {
+    if (a->base) munmap(a->base, a->size);
+    memset(a, 0, sizeof(*a));
+}
+
+#endif // !BAREMETAL
+
+#endif // BENCH_MEM_H
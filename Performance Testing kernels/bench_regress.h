@@ -0,0 +1,238 @@
+// Per-config regression check: a fixed suite is measured and compared with
+// a stored baseline; a metric that got worse by more than the threshold
+// fails the run
+//
+//   -DBENCH_BASELINE='"baselines/Ara4096GemminiRocketConfig.h"'
+//   -DBENCH_REGRESS_PCT=<n>       cycle tolerance in percent (default 5)
+//   -DBENCH_REGRESS_HPM_PCT=<n>   instret/HPM counter tolerance (default 10)
+//   -DBENCH_REGRESS_HPM_SLACK=<n> counter increase always accepted (default 16)
+//
+//   bench_regress_check(desc, &st);   // After each BENCH_RUN; 1 = regressed
+//   bench_regress_dump();             // Once: the run as a new baseline
+//
+// A baseline file is what bench_regress_dump() prints between
+// "#BENCH_BASELINE_BEGIN" and "#BENCH_BASELINE_END": a BENCH_BASELINE_FOR
+// define naming the config it was captured on, then one
+// BENCH_BASELINE_ENTRY(kernel, backend, dtype, m, n, k, cycles, instret,
+// hpm_group, counters...) line per measurement. Counters are only compared
+// when the baseline was taken with the same HPM group. Measurements without
+// a baseline entry are reported as new and do not fail the run; getting
+// faster than the tolerance is reported so the baseline can be refreshed.
+// Everything here is defined only with -DSUITE_MODE.
+
+#ifndef BENCH_REGRESS_H
+#define BENCH_REGRESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hpm_utils.h"
+#include "bench_stats.h"
+#include "bench_report.h"
+
+#ifdef SUITE_MODE
+
+#ifndef BENCH_REGRESS_PCT
+#define BENCH_REGRESS_PCT 5
+#endif
+#ifndef BENCH_REGRESS_HPM_PCT
+#define BENCH_REGRESS_HPM_PCT 10
+#endif
+#ifndef BENCH_REGRESS_HPM_SLACK
+#define BENCH_REGRESS_HPM_SLACK 16
+#endif
+
+// Measurements kept for bench_regress_dump()
+#ifndef BENCH_REGRESS_MAX_ENTRIES
+#define BENCH_REGRESS_MAX_ENTRIES 64
+#endif
+
+typedef struct {
+    const char* kernel;  // NULL ends the table
+    const char* backend;
+    const char* dtype;
+    size_t m, n, k;
+    uint64_t cycles;     // Median
+    uint64_t instret;
+    const char* hpm_group;
+    uint64_t counters[HPM_NUM_COUNTERS];
+} bench_baseline_t;
+
+#define BENCH_BASELINE_ENTRY(kernel, backend, dtype, m, n, k, cycles, instret, group, ...) \
+    { (kernel), (backend), (dtype), (m), (n), (k), (cycles), (instret), (group), { __VA_ARGS__ } },
+
+static const bench_baseline_t bench_baseline[] = {
+#ifdef BENCH_BASELINE
+#include BENCH_BASELINE
+#endif
+    { NULL, NULL, NULL, 0, 0, 0, 0, 0, NULL, { 0 } },
+};
+
+#ifndef BENCH_BASELINE_FOR
+#define BENCH_BASELINE_FOR "none"
+#endif
+
+typedef enum {
+    BENCH_REGRESS_NEW,     // No baseline entry
+    BENCH_REGRESS_OK,
+    BENCH_REGRESS_FASTER,  // Cycles improved beyond the tolerance
+    BENCH_REGRESS_SLOWER,  // Cycles or a counter regressed
+} bench_regress_status_t;
+
+static bench_baseline_t bench_regress_log[BENCH_REGRESS_MAX_ENTRIES];
+static size_t bench_regress_logged = 0;
+static size_t bench_regress_counts[BENCH_REGRESS_SLOWER + 1];
+
+static const bench_baseline_t* bench_baseline_find(const bench_desc_t* d) {
+    for (const bench_baseline_t* b = bench_baseline; b->kernel; b++) {
+        if (strcmp(b->kernel, d->kernel) == 0 && strcmp(b->backend, d->backend) == 0 &&
+            strcmp(b->dtype, d->dtype) == 0 && b->m == d->m && b->n == d->n && b->k == d->k) {
+            return b;
+        }
+    }
+    return NULL;
+}
+
+// True when `now` exceeds `base` by more than pct percent plus `slack`
+static inline int bench_regress_worse(uint64_t now, uint64_t base, uint64_t pct, uint64_t slack) {
+    return now * 100 > base * (100 + pct) + slack * 100;
+}
+
+// Signed change from base to now in tenths of a percent
+static inline int64_t bench_regress_delta_x10(uint64_t now, uint64_t base) {
+    if (base == 0) return 0;
+    return ((int64_t)now - (int64_t)base) * 1000 / (int64_t)base;
+}
+
+static void bench_regress_print_delta(int64_t delta_x10) {
+    const uint64_t mag = (uint64_t)(delta_x10 < 0 ? -delta_x10 : delta_x10);
+    printf("%c%3llu.%llu%%", delta_x10 < 0 ? '-' : '+',
+           (unsigned long long)(mag / 10), (unsigned long long)(mag % 10));
+}
+
+static void bench_regress_print_header(void) {
+    printf("Baseline: %s (running on %s); tolerance %d%% cycles, %d%% counters\n",
+           BENCH_BASELINE_FOR, BENCH_CONFIG, BENCH_REGRESS_PCT, BENCH_REGRESS_HPM_PCT);
+    if (strcmp(BENCH_BASELINE_FOR, "none") != 0 && strcmp(BENCH_BASELINE_FOR, BENCH_CONFIG) != 0) {
+        printf("WARNING: baseline was captured on a different config\n");
+    }
+    printf("\n");
+    printf("| Kernel                | Backend        | Shape          | Baseline   | Cycles     | Change  | Status  |\n");
+    printf("|-----------------------|----------------|----------------|------------|------------|---------|---------|\n");
+}
+
+// Compare one measurement (the median run's counters) with the baseline,
+// print its row and remember it for the dump. Returns 1 on a regression.
+static int bench_regress_check(const bench_desc_t* d, const bench_stats_t* st) {
+    static const char* const status_names[] = { "new", "ok", "FASTER", "SLOWER" };
+    const hpm_region_t* run = &st->runs[st->median_idx];
+    const hpm_group_t* g = &HPM_GROUP;
+    const bench_baseline_t* b = bench_baseline_find(d);
+    bench_regress_status_t status = BENCH_REGRESS_NEW;
+    int counters_worse = 0;
+
+    if (b) {
+        status = BENCH_REGRESS_OK;
+        if (bench_regress_worse(st->median, b->cycles, BENCH_REGRESS_PCT, 0)) {
+            status = BENCH_REGRESS_SLOWER;
+        } else if (bench_regress_worse(b->cycles, st->median, BENCH_REGRESS_PCT, 0)) {
+            status = BENCH_REGRESS_FASTER;
+        }
+        if (bench_regress_worse(run->delta.instret, b->instret, BENCH_REGRESS_HPM_PCT,
+                                BENCH_REGRESS_HPM_SLACK)) {
+            counters_worse = 1;
+        }
+        if (b->hpm_group && strcmp(b->hpm_group, g->name) == 0) {
+            for (size_t i = 0; i < g->num_events; i++) {
+                if (bench_regress_worse(run->delta.counters[i], b->counters[i],
+                                        BENCH_REGRESS_HPM_PCT, BENCH_REGRESS_HPM_SLACK)) {
+                    counters_worse = 1;
+                }
+            }
+        }
+        if (counters_worse) status = BENCH_REGRESS_SLOWER;
+    }
+    bench_regress_counts[status]++;
+
+    char shape[24];
+    snprintf(shape, sizeof(shape), "%zux%zux%zu", d->m, d->n, d->k);
+    printf("| %-21s | %-14s | %-14s | ", d->kernel, d->backend, shape);
+    if (b) {
+        printf("%10llu | %10llu | ", (unsigned long long)b->cycles,
+               (unsigned long long)st->median);
+        bench_regress_print_delta(bench_regress_delta_x10(st->median, b->cycles));
+    } else {
+        printf("%10s | %10llu | %7s", "-", (unsigned long long)st->median, "");
+    }
+    printf(" | %-7s |\n", status_names[status]);
+
+    // Which counters moved, for a regression that is not in the cycles
+    if (counters_worse) {
+        printf("    instret %llu -> %llu", (unsigned long long)b->instret,
+               (unsigned long long)run->delta.instret);
+        if (b->hpm_group && strcmp(b->hpm_group, g->name) == 0) {
+            for (size_t i = 0; i < g->num_events; i++) {
+                if (bench_regress_worse(run->delta.counters[i], b->counters[i],
+                                        BENCH_REGRESS_HPM_PCT, BENCH_REGRESS_HPM_SLACK)) {
+                    printf(", %s %llu -> %llu", g->keys[i], (unsigned long long)b->counters[i],
+                           (unsigned long long)run->delta.counters[i]);
+                }
+            }
+        }
+        printf("\n");
+    }
+
+    if (bench_regress_logged < BENCH_REGRESS_MAX_ENTRIES) {
+        bench_baseline_t* e = &bench_regress_log[bench_regress_logged++];
+        e->kernel = d->kernel;
+        e->backend = d->backend;
+        e->dtype = d->dtype;
+        e->m = d->m;
+        e->n = d->n;
+        e->k = d->k;
+        e->cycles = st->median;
+        e->instret = run->delta.instret;
+        e->hpm_group = g->name;
+        for (size_t i = 0; i < HPM_NUM_COUNTERS; i++) {
+            e->counters[i] = i < g->num_events ? run->delta.counters[i] : 0;
+        }
+    }
+    return status == BENCH_REGRESS_SLOWER;
+}
+
+// Totals line; returns 1 if anything regressed
+static int bench_regress_summary(void) {
+    printf("\n");
+    printf("Regression check: %zu ok, %zu faster, %zu slower, %zu without baseline\n",
+           bench_regress_counts[BENCH_REGRESS_OK], bench_regress_counts[BENCH_REGRESS_FASTER],
+           bench_regress_counts[BENCH_REGRESS_SLOWER], bench_regress_counts[BENCH_REGRESS_NEW]);
+    if (bench_regress_counts[BENCH_REGRESS_FASTER]) {
+        printf("Faster results: refresh the baseline once the gain is confirmed\n");
+    }
+    return bench_regress_counts[BENCH_REGRESS_SLOWER] != 0;
+}
+
+// Print every checked measurement as a baseline file for this config
+static void bench_regress_dump(void) {
+    printf("#BENCH_BASELINE_BEGIN\n");
+    printf("// Baseline captured by bench_regress_dump(); reps=%d warmup=%d\n",
+           BENCH_REPS, BENCH_WARMUP);
+    printf("#define BENCH_BASELINE_FOR \"%s\"\n", BENCH_CONFIG);
+    for (size_t i = 0; i < bench_regress_logged; i++) {
+        const bench_baseline_t* e = &bench_regress_log[i];
+        printf("BENCH_BASELINE_ENTRY(\"%s\", \"%s\", \"%s\", %zu, %zu, %zu, %llu, %llu, \"%s\"",
+               e->kernel, e->backend, e->dtype, e->m, e->n, e->k,
+               (unsigned long long)e->cycles, (unsigned long long)e->instret, e->hpm_group);
+        for (size_t c = 0; c < HPM_NUM_COUNTERS; c++) {
+            printf(", %llu", (unsigned long long)e->counters[c]);
+        }
+        printf(")\n");
+    }
+    printf("#BENCH_BASELINE_END\n");
+}
+
+#endif // SUITE_MODE
+
+#endif // BENCH_REGRESS_H
@@ -0,0 +1,136 @@
+// Machine-readable benchmark records (CSV or JSON lines)
+// One record per measurement, interleaved with the human-readable output
+//
+//   -DBENCH_OUTPUT=BENCH_OUTPUT_CSV   lines start with "csv," (header once)
+//   -DBENCH_OUTPUT=BENCH_OUTPUT_JSON  one JSON object per line, starting '{'
+//   -DBENCH_CONFIG='"Ara4096GemminiRocketConfig"' tags every record
+//
+// Speedups are fixed-point (x10000) and printed with four decimals because
+// the bare-metal printf has no %f.
+
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hpm_utils.h"
+#include "bench_stats.h"
+
+#define BENCH_OUTPUT_TEXT 0  // Records suppressed (default)
+#define BENCH_OUTPUT_CSV  1
+#define BENCH_OUTPUT_JSON 2
+
+#ifndef BENCH_OUTPUT
+#define BENCH_OUTPUT BENCH_OUTPUT_TEXT
+#endif
+
+#ifndef BENCH_CONFIG
+#define BENCH_CONFIG "unknown"
+#endif
+
+// What was measured. Vector kernels use n for the length and m = k = 1.
+typedef struct {
+    const char* kernel;   // "saxpy", "matmul", "dot", ...
+    const char* backend;  // "scalar", "ara", "gemmini", ...
+    const char* dtype;    // "int32", "int8", "int8->int32", ...
+    size_t m, n, k;
+} bench_desc_t;
+
+#define BENCH_DESC(kernel, backend, dtype, m, n, k) \
+    (&(bench_desc_t){ (kernel), (backend), (dtype), (m), (n), (k) })
+
+// Cycle summary of one measurement; `hpm` may be NULL when only mcycle
+// was sampled
+typedef struct {
+    size_t reps;
+    uint64_t cycles;      // Median (or the single sample)
+    uint64_t cycles_min;
+    uint64_t cycles_max;
+    const hpm_region_t* hpm;
+} bench_result_t;
+
+#if BENCH_OUTPUT == BENCH_OUTPUT_CSV
+static int bench_csv_header_done = 0;
+#endif
+
+static inline void bench_emit_result(const bench_desc_t* d, const bench_result_t* r,
+                                     uint64_t base_cycles) {
+#if BENCH_OUTPUT != BENCH_OUTPUT_TEXT
+    const hpm_group_t* g = &HPM_GROUP;
+    uint64_t speedup_x10000 = (base_cycles && r->cycles) ? base_cycles * 10000 / r->cycles : 0;
+#endif
+
+#if BENCH_OUTPUT == BENCH_OUTPUT_CSV
+    if (!bench_csv_header_done) {
+        printf("csv,config,kernel,backend,dtype,m,n,k,reps,cycles,cycles_min,cycles_max,instret");
+        for (size_t i = 0; i < g->num_events; i++) printf(",%s", g->keys[i]);
+        printf(",speedup\n");
+        bench_csv_header_done = 1;
+    }
+    printf("csv,%s,%s,%s,%s,%zu,%zu,%zu,%zu,%llu,%llu,%llu,",
+           BENCH_CONFIG, d->kernel, d->backend, d->dtype, d->m, d->n, d->k, r->reps,
+           (unsigned long long)r->cycles,
+           (unsigned long long)r->cycles_min,
+           (unsigned long long)r->cycles_max);
+    if (r->hpm) printf("%llu", (unsigned long long)r->hpm->delta.instret);
+    for (size_t i = 0; i < g->num_events; i++) {
+        if (r->hpm) printf(",%llu", (unsigned long long)r->hpm->delta.counters[i]);
+        else printf(",");
+    }
+    if (base_cycles) {
+        printf(",%llu.%04llu\n", (unsigned long long)(speedup_x10000 / 10000),
+               (unsigned long long)(speedup_x10000 % 10000));
+    } else {
+        printf(",\n");
+    }
+#elif BENCH_OUTPUT == BENCH_OUTPUT_JSON
+    printf("{\"config\":\"%s\",\"kernel\":\"%s\",\"backend\":\"%s\",\"dtype\":\"%s\","
+           "\"m\":%zu,\"n\":%zu,\"k\":%zu,\"reps\":%zu,"
+           "\"cycles\":%llu,\"cycles_min\":%llu,\"cycles_max\":%llu",
+           BENCH_CONFIG, d->kernel, d->backend, d->dtype, d->m, d->n, d->k, r->reps,
+           (unsigned long long)r->cycles,
+           (unsigned long long)r->cycles_min,
+           (unsigned long long)r->cycles_max);
+    if (r->hpm) {
+        printf(",\"instret\":%llu,\"hpm_group\":\"%s\",\"hpm\":{",
+               (unsigned long long)r->hpm->delta.instret, g->name);
+        for (size_t i = 0; i < g->num_events; i++) {
+            printf("%s\"%s\":%llu", i ? "," : "", g->keys[i],
+                   (unsigned long long)r->hpm->delta.counters[i]);
+        }
+        printf("}");
+    }
+    if (base_cycles) {
+        printf(",\"speedup\":%llu.%04llu}\n", (unsigned long long)(speedup_x10000 / 10000),
+               (unsigned long long)(speedup_x10000 % 10000));
+    } else {
+        printf(",\"speedup\":null}\n");
+    }
+#else
+    (void)d; (void)r; (void)base_cycles;
+#endif
+}
+
+// Record a BENCH_RUN result. base_cycles is the baseline median for the
+// speedup field (0 = no baseline); the same convention applies below.
+static inline void bench_emit(const bench_desc_t* d, const bench_stats_t* st, uint64_t base_cycles) {
+    bench_result_t r = { st->count, st->median, st->min, st->max, &st->runs[st->median_idx] };
+    bench_emit_result(d, &r, base_cycles);
+}
+
+// Record a single HPM-sampled region
+static inline void bench_emit_region(const bench_desc_t* d, const hpm_region_t* hpm,
+                                     uint64_t base_cycles) {
+    bench_result_t r = { 1, hpm->delta.cycles, hpm->delta.cycles, hpm->delta.cycles, hpm };
+    bench_emit_result(d, &r, base_cycles);
+}
+
+// Record a bare mcycle delta
+static inline void bench_emit_cycles(const bench_desc_t* d, uint64_t cycles, uint64_t base_cycles) {
+    bench_result_t r = { 1, cycles, cycles, cycles, NULL };
+    bench_emit_result(d, &r, base_cycles);
+}
+
+#endif // BENCH_REPORT_H
@@ -0,0 +1,141 @@
+// Multi-hart benchmark support: hart discovery, a sense-reversing barrier
+// and a command loop that parks the secondary harts between measurements
+//
+// Everything but the hart masks is defined only with -DMULTI_HART. The
+// bare-metal crt calls thread_entry(cid, nc) on every hart before main and
+// this header defines it: hart 0 records the hart count and returns to run
+// main(); every other hart enters bench_smp_worker() and never returns.
+// Hart 0 then drives the workers with bench_smp_run(); only hart 0 prints.
+//
+//   static void part(size_t hart, size_t active) { ... }
+//   bench_smp_run(part, active, cycles);   // cycles[h] = hart h's run
+//   bench_smp_shutdown();                  // Before main() returns
+
+#ifndef BENCH_SMP_H
+#define BENCH_SMP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "bench_kernels.h"
+#include "bench_trace.h"
+
+// Harts whose tile has a Gemmini / an Ara (bit h = hart h). RoCC and vector
+// instructions trap on tiles without the unit, so these default to hart 0.
+#ifndef BENCH_GEMMINI_HART_MASK
+#define BENCH_GEMMINI_HART_MASK 0x1
+#endif
+#ifndef BENCH_ARA_HART_MASK
+#define BENCH_ARA_HART_MASK 0x1
+#endif
+
+#define BENCH_HART_HAS(mask, h) ((((uint64_t)(mask)) >> (h)) & 1)
+
+#ifdef MULTI_HART
+#ifndef BAREMETAL
+#error "MULTI_HART needs the bare-metal crt (thread_entry on every hart)"
+#endif
+
+// Work item for hart `hart` when `active` harts take part (hart < active)
+typedef void (*bench_smp_part_t)(size_t hart, size_t active);
+
+static volatile size_t bench_smp_harts = 1;  // Set by thread_entry
+
+// Barrier state: arrivals and a sense flag flipped by the last arrival
+static volatile uint32_t bench_smp_count = 0;
+static volatile uint32_t bench_smp_sense = 0;
+
+// Command for the workers, published by hart 0 before the start barrier
+static volatile bench_smp_part_t bench_smp_part = NULL;
+static volatile size_t bench_smp_active = 0;
+static volatile int bench_smp_quit = 0;
+static volatile uint64_t bench_smp_cycles[BENCH_MAX_HARTS];
+
+static inline size_t bench_smp_num_harts(void) {
+    return bench_smp_harts < BENCH_MAX_HARTS ? bench_smp_harts : BENCH_MAX_HARTS;
+}
+
+// All bench_smp_num_harts() harts must call this
+static void bench_smp_barrier(void) {
+    const uint32_t sense = !bench_smp_sense;
+    if (__atomic_add_fetch(&bench_smp_count, 1, __ATOMIC_ACQ_REL) == bench_smp_num_harts()) {
+        bench_smp_count = 0;
+        __atomic_store_n(&bench_smp_sense, sense, __ATOMIC_RELEASE);
+    } else {
+        while (__atomic_load_n(&bench_smp_sense, __ATOMIC_ACQUIRE) != sense) { }
+    }
+}
+
+// [begin, end) of `total` units for one of `parts` partitions, split in
+// multiples of `granule` so Gemmini partitions stay tile-aligned
+static void bench_smp_partition(size_t total, size_t granule, size_t parts, size_t idx,
+                                size_t* begin, size_t* end) {
+    const size_t blocks = CEIL_DIV(total, granule);
+    const size_t b0 = blocks * idx / parts, b1 = blocks * (idx + 1) / parts;
+    *begin = MIN(b0 * granule, total);
+    *end = MIN(b1 * granule, total);
+}
+
+// One hart's share of a command: timed between the start and stop barriers
+static void bench_smp_step(size_t hart) {
+    const bench_smp_part_t part = bench_smp_part;
+    const size_t active = bench_smp_active;
+    uint64_t cycles = 0;
+    if (hart < active && part) {
+        uint64_t start = read_csr_mcycle();
+        part(hart, active);
+        cycles = read_csr_mcycle() - start;
+        bench_trace_end("smp_part", start);
+    }
+    bench_smp_cycles[hart] = cycles;
+    bench_smp_barrier();
+}
+
+// Secondary harts: wait for a command, run it, repeat until shutdown
+static void bench_smp_worker(size_t hart) {
+    if (BENCH_HART_HAS(BENCH_ARA_HART_MASK, hart)) enable_vector_extension();
+    for (;;) {
+        bench_smp_barrier();
+        if (bench_smp_quit) break;
+        bench_smp_step(hart);
+    }
+    for (;;) asm volatile("wfi");
+}
+
+// Hart 0: run `part` on harts 0..active-1 and wait for all of them.
+// cycles[h] receives hart h's own mcycle delta (0 for idle harts); the
+// return value is hart 0's wall time from the start to the stop barrier.
+// mcycle is per hart, so only the per-hart deltas are comparable.
+static uint64_t bench_smp_run(bench_smp_part_t part, size_t active, uint64_t* cycles) {
+    const size_t harts = bench_smp_num_harts();
+    bench_smp_part = part;
+    bench_smp_active = MIN(active, harts);
+
+    bench_smp_barrier();
+    uint64_t start = read_csr_mcycle();
+    bench_smp_step(0);
+    uint64_t wall = read_csr_mcycle() - start;
+
+    for (size_t h = 0; h < harts; h++) cycles[h] = bench_smp_cycles[h];
+    return wall;
+}
+
+// Release the workers into wfi; no bench_smp_run() after this
+static void bench_smp_shutdown(void) {
+    bench_smp_quit = 1;
+    bench_smp_barrier();
+}
+
+void thread_entry(int cid, int nc) {
+    if (cid == 0) {
+        bench_smp_harts = (size_t)nc;
+        return;
+    }
+    // Workers spin until hart 0 has published the hart count
+    while (bench_smp_harts != (size_t)nc) { }
+    if ((size_t)cid < BENCH_MAX_HARTS) bench_smp_worker((size_t)cid);
+    for (;;) asm volatile("wfi");
+}
+#endif // MULTI_HART
+
+#endif // BENCH_SMP_H
@@ -0,0 +1,110 @@
+// Statistical benchmark harness: warmup, repetitions and min/median/max
+// Each repetition is sampled with an hpm_region_t; the median run's HPM
+// deltas are reported so counters and cycles describe the same run
+
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "hpm_utils.h"
+
+// Untimed warmup iterations and timed repetitions per measurement
+#ifndef BENCH_WARMUP
+#define BENCH_WARMUP 1
+#endif
+#ifndef BENCH_REPS
+#define BENCH_REPS 5
+#endif
+
+#define BENCH_MAX_REPS 16
+
+#if BENCH_REPS > BENCH_MAX_REPS
+#error "BENCH_REPS exceeds BENCH_MAX_REPS"
+#endif
+
+typedef struct {
+    size_t count;
+    hpm_region_t runs[BENCH_MAX_REPS];
+    uint64_t min;
+    uint64_t median;
+    uint64_t max;
+    uint64_t mean;
+    uint64_t spread_x10;  // (max - min) / median in tenths of a percent
+    size_t median_idx;    // Index into runs[] of the median repetition
+} bench_stats_t;
+
+static inline void bench_stats_init(bench_stats_t* st) {
+    st->count = 0;
+}
+
+static inline void bench_stats_add(bench_stats_t* st, const hpm_region_t* r) {
+    if (st->count < BENCH_MAX_REPS) {
+        st->runs[st->count++] = *r;
+    }
+}
+
+static inline void bench_stats_finalize(bench_stats_t* st) {
+    size_t order[BENCH_MAX_REPS];
+    uint64_t total = 0;
+
+    if (st->count == 0) {
+        st->min = st->median = st->max = st->mean = st->spread_x10 = 0;
+        st->median_idx = 0;
+        return;
+    }
+
+    // Insertion sort of run indices by cycle count
+    for (size_t i = 0; i < st->count; i++) {
+        size_t j = i;
+        while (j > 0 && st->runs[order[j - 1]].delta.cycles > st->runs[i].delta.cycles) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+        total += st->runs[i].delta.cycles;
+    }
+
+    st->median_idx = order[(st->count - 1) / 2];
+    st->min = st->runs[order[0]].delta.cycles;
+    st->max = st->runs[order[st->count - 1]].delta.cycles;
+    st->median = st->runs[st->median_idx].delta.cycles;
+    st->mean = total / st->count;
+    st->spread_x10 = st->median ? (st->max - st->min) * 1000 / st->median : 0;
+}
+
+// Run `setup` (untimed) then the kernel statements (timed) BENCH_WARMUP +
+// BENCH_REPS times. Only the timed repetitions are added to `st`.
+#define BENCH_RUN(st, setup, ...) do {                                  \
+    bench_stats_init(st);                                               \
+    for (size_t __rep = 0; __rep < BENCH_WARMUP + BENCH_REPS; __rep++) {\
+        hpm_region_t __perf;                                            \
+        setup;                                                          \
+        hpm_start(&__perf, &HPM_GROUP);                                 \
+        __VA_ARGS__;                                                    \
+        hpm_stop(&__perf);                                              \
+        if (__rep >= BENCH_WARMUP) bench_stats_add(st, &__perf);        \
+    }                                                                   \
+    bench_stats_finalize(st);                                           \
+} while (0)
+
+// Speedup of `x` over `base` from medians, scaled by 100
+static inline uint64_t bench_speedup_x100(const bench_stats_t* base, const bench_stats_t* x) {
+    return x->median ? base->median * 100 / x->median : 0;
+}
+
+// Print the cycle distribution and the median run's HPM counters
+static inline void bench_print_stats(const bench_stats_t* st) {
+    printf("  Cycles (median): %llu\n", (unsigned long long)st->median);
+    printf("  Cycles (min/max): %llu / %llu\n",
+           (unsigned long long)st->min, (unsigned long long)st->max);
+    printf("  Spread: %llu.%llu%% over %zu reps (%d warmup)\n",
+           (unsigned long long)(st->spread_x10 / 10),
+           (unsigned long long)(st->spread_x10 % 10),
+           st->count, BENCH_WARMUP);
+    hpm_print_counters(&st->runs[st->median_idx]);
+}
+
+#endif // BENCH_STATS_H
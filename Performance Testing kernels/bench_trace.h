@@ -0,0 +1,170 @@
+// Cycle-timeline tracer: named regions recorded into a static ring buffer
+// and dumped at exit as Chrome trace JSON (chrome://tracing, Perfetto)
+//
+//   -DBENCH_TRACE                 enable (otherwise every call compiles away)
+//   -DBENCH_TRACE_CAPACITY=<n>    events kept; older ones are overwritten
+//   -DBENCH_TRACE_MHZ=<n>         core clock in MHz, to emit real microseconds
+//
+//   uint64_t t = bench_trace_begin();
+//   gemmini_tiled_matmul_os_issue(...);
+//   bench_trace_end("gemmini_issue", t);
+//   ...
+//   bench_trace_dump();           // Once, before exit
+//
+// A region's id is the address of its name, so names must be string
+// literals (or otherwise outlive the dump). Recording an event is two
+// mcycle reads and four stores, with no lookup or printing on the hot
+// path; the dump reports the measured per-region cost so traced cycle
+// counts can be corrected or dismissed.
+//
+// The dump sits between "#BENCH_TRACE_BEGIN" and "#BENCH_TRACE_END" lines
+// and tid is the hart. Chrome reads ts and dur as microseconds: with
+// BENCH_TRACE_MHZ set they are cycles / MHz, otherwise they are raw cycles,
+// so 1 us in the viewer is 1 cycle. otherData.time_unit records which.
+
+#ifndef BENCH_TRACE_H
+#define BENCH_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "bench_kernels.h"
+#include "bench_report.h"
+
+#ifndef BENCH_TRACE_CAPACITY
+#define BENCH_TRACE_CAPACITY 4096
+#endif
+
+// 0 = emit cycles unscaled
+#ifndef BENCH_TRACE_MHZ
+#define BENCH_TRACE_MHZ 0
+#endif
+
+// Empty regions recorded by the overhead calibration in bench_trace_dump()
+#define BENCH_TRACE_CALIB_SAMPLES 15
+
+#if BENCH_TRACE_CAPACITY <= BENCH_TRACE_CALIB_SAMPLES
+#error "BENCH_TRACE_CAPACITY must exceed BENCH_TRACE_CALIB_SAMPLES"
+#endif
+
+#ifdef BENCH_TRACE
+
+typedef struct {
+    const char* name;  // Region id
+    uint64_t start;    // mcycle
+    uint64_t end;
+    uint32_t hart;
+} bench_trace_event_t;
+
+static bench_trace_event_t bench_trace_buf[BENCH_TRACE_CAPACITY];
+static volatile uint64_t bench_trace_count = 0;  // Events ever recorded
+
+static inline uint32_t bench_trace_hart(void) {
+#ifdef BAREMETAL
+    uint64_t id;
+    asm volatile("csrr %0, mhartid" : "=r"(id));
+    return (uint32_t)id;
+#else
+    return 0;  // mhartid is not readable from user mode
+#endif
+}
+
+static inline uint64_t bench_trace_begin(void) {
+    return read_csr_mcycle();
+}
+
+static inline void bench_trace_end(const char* name, uint64_t start) {
+    const uint64_t end = read_csr_mcycle();
+#ifdef MULTI_HART
+    const uint64_t idx = __atomic_fetch_add(&bench_trace_count, 1, __ATOMIC_RELAXED);
+#else
+    const uint64_t idx = bench_trace_count++;
+#endif
+    bench_trace_event_t* e = &bench_trace_buf[idx % BENCH_TRACE_CAPACITY];
+    e->name = name;
+    e->start = start;
+    e->end = end;
+    e->hart = bench_trace_hart();
+}
+
+// Median cost of recording one empty region, in cycles. The samples land
+// in the slots after the newest event and are then discarded.
+static uint64_t bench_trace_overhead(void) {
+    enum { SAMPLES = BENCH_TRACE_CALIB_SAMPLES };
+    uint64_t cost[SAMPLES];
+    const uint64_t saved = bench_trace_count;
+    for (size_t i = 0; i < SAMPLES; i++) {
+        uint64_t t0 = read_csr_mcycle();
+        bench_trace_end("calibrate", bench_trace_begin());
+        cost[i] = read_csr_mcycle() - t0;
+    }
+    bench_trace_count = saved;  // Calibration events are not part of the run
+
+    // Insertion sort; SAMPLES is small
+    for (size_t i = 1; i < SAMPLES; i++) {
+        uint64_t v = cost[i];
+        size_t j = i;
+        while (j > 0 && cost[j - 1] > v) {
+            cost[j] = cost[j - 1];
+            j--;
+        }
+        cost[j] = v;
+    }
+    return cost[SAMPLES / 2];
+}
+
+// Print a cycle count in the trace time unit: microseconds to the
+// nanosecond when BENCH_TRACE_MHZ is set, cycles otherwise
+static void bench_trace_print_time(uint64_t cycles) {
+#if BENCH_TRACE_MHZ > 0
+    const uint64_t ns = cycles * 1000 / BENCH_TRACE_MHZ;
+    printf("%llu.%03llu", (unsigned long long)(ns / 1000), (unsigned long long)(ns % 1000));
+#else
+    printf("%llu", (unsigned long long)cycles);
+#endif
+}
+
+// Print the retained events, oldest first, as one Chrome trace object. The
+// oldest BENCH_TRACE_CALIB_SAMPLES slots of a full ring are given up to
+// the calibration.
+static void bench_trace_dump(void) {
+    const uint64_t total = bench_trace_count;
+    const uint64_t room = BENCH_TRACE_CAPACITY - BENCH_TRACE_CALIB_SAMPLES;
+    const uint64_t kept = total < room ? total : room;
+    const uint64_t first = total - kept;
+    const uint64_t overhead = bench_trace_overhead();
+
+    printf("#BENCH_TRACE_BEGIN\n");
+    printf("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"clock\":\"mcycle\",\"config\":\"%s\","
+           "\"events\":%llu,\"dropped\":%llu,\"overhead_cycles\":%llu,",
+           BENCH_CONFIG, (unsigned long long)total, (unsigned long long)first,
+           (unsigned long long)overhead);
+#if BENCH_TRACE_MHZ > 0
+    printf("\"time_unit\":\"us at %d MHz\"},\n", (int)BENCH_TRACE_MHZ);
+#else
+    printf("\"time_unit\":\"cycle (1 us in the viewer = 1 cycle)\"},\n");
+#endif
+    printf("\"traceEvents\":[\n");
+    for (uint64_t i = first; i < total; i++) {
+        const bench_trace_event_t* e = &bench_trace_buf[i % BENCH_TRACE_CAPACITY];
+        printf("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":",
+               e->name, (unsigned)e->hart);
+        bench_trace_print_time(e->start);
+        printf(",\"dur\":");
+        bench_trace_print_time(e->end - e->start);
+        printf("}%s\n", i + 1 < total ? "," : "");
+    }
+    printf("]}\n");
+    printf("#BENCH_TRACE_END\n");
+}
+
+#else // !BENCH_TRACE
+
+static inline uint64_t bench_trace_begin(void) { return 0; }
+static inline void bench_trace_end(const char* name, uint64_t start) { (void)name; (void)start; }
+static inline void bench_trace_dump(void) { }
+
+#endif // BENCH_TRACE
+
+#endif // BENCH_TRACE_H
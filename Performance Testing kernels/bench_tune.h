@@ -0,0 +1,242 @@
+// Gemmini schedule auto-tuner: enumerates the tiled schedules that fit
+// this config's scratchpad and accumulator for one GEMM shape, times them
+// and prints the winners as a table gemmini_tuned_schedule() can load
+//
+//   -DGEMMINI_TUNE_MAX_CANDIDATES=<n>  screened per shape (default 256)
+//   -DGEMMINI_TUNE_FINALISTS=<n>       re-timed with BENCH_RUN (default 4)
+//
+//   gemmini_tune_result_t r;
+//   gemmini_tune(A, B, C, ref, M, N, K, &r);   // r.best, r.best_st
+//   ...
+//   gemmini_tune_dump();                        // Once: every tuned shape
+//
+// The space is tile_i and tile_j in powers of two (plus the full tile
+// count), the largest tile_k that fits with its half and quarter, the OS
+// kernel single- and double-buffered in both block orders, and the WS
+// kernel. Large blocks are enumerated first, so a low candidate cap drops
+// the smallest ones. Each candidate is screened with one run after a TLB
+// flush; the fastest GEMMINI_TUNE_FINALISTS are timed again as medians and
+// checked against `ref`. The dump sits between "#GEMMINI_TUNED_BEGIN" and
+// "#GEMMINI_TUNED_END" and is a valid GEMMINI_TUNED_TABLE file.
+// Everything here is defined only with -DTUNE_MODE.
+
+#ifndef BENCH_TUNE_H
+#define BENCH_TUNE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "bench_kernels.h"
+#include "bench_stats.h"
+#include "bench_report.h"
+
+#ifdef TUNE_MODE
+
+#ifndef GEMMINI_TUNE_MAX_CANDIDATES
+#define GEMMINI_TUNE_MAX_CANDIDATES 256
+#endif
+#ifndef GEMMINI_TUNE_FINALISTS
+#define GEMMINI_TUNE_FINALISTS 4
+#endif
+
+// Shapes kept for gemmini_tune_dump()
+#ifndef GEMMINI_TUNE_MAX_SHAPES
+#define GEMMINI_TUNE_MAX_SHAPES 16
+#endif
+
+typedef struct {
+    gemmini_schedule_t s;
+    uint64_t cycles;  // Screening run
+} gemmini_tune_cand_t;
+
+typedef struct {
+    size_t m, n, k;
+    gemmini_schedule_t best;
+    bench_stats_t best_st;
+    gemmini_tune_cand_t finalists[GEMMINI_TUNE_FINALISTS];
+    uint64_t finalist_median[GEMMINI_TUNE_FINALISTS];
+    size_t num_finalists;
+    size_t candidates;  // Screened
+    size_t dropped;     // Legal schedules beyond GEMMINI_TUNE_MAX_CANDIDATES
+    int errors;         // Finalist mismatches and failed runs
+} gemmini_tune_result_t;
+
+static gemmini_tune_cand_t gemmini_tune_cands[GEMMINI_TUNE_MAX_CANDIDATES];
+
+static gemmini_tuned_t gemmini_tune_log[GEMMINI_TUNE_MAX_SHAPES];
+static uint64_t gemmini_tune_log_cycles[GEMMINI_TUNE_MAX_SHAPES];
+static size_t gemmini_tune_logged = 0;
+
+static const char* gemmini_order_name(gemmini_order_t o) {
+    return o == GEMMINI_ORDER_JI ? "GEMMINI_ORDER_JI" : "GEMMINI_ORDER_IJ";
+}
+
+static const char* gemmini_sched_name(gemmini_sched_t s) {
+    switch (s) {
+    case GEMMINI_SCHED_SERIAL: return "GEMMINI_SCHED_SERIAL";
+    case GEMMINI_SCHED_DOUBLE_BUFFER: return "GEMMINI_SCHED_DOUBLE_BUFFER";
+    default: return "GEMMINI_SCHED_SINGLE_BUFFER";
+    }
+}
+
+// Short form for tables, e.g. "OS/db ji 4x2x8" or "WS 4x4x16"
+static void gemmini_schedule_format(const gemmini_schedule_t* s, char* buf, size_t len) {
+    if (s->dataflow == WEIGHT_STATIONARY) {
+        snprintf(buf, len, "WS %zux%zux%zu", s->cfg.tile_i, s->cfg.tile_j, s->cfg.tile_k);
+    } else {
+        snprintf(buf, len, "OS/%s %s %zux%zux%zu",
+                 s->sched == GEMMINI_SCHED_DOUBLE_BUFFER ? "db" : "sb",
+                 s->cfg.order == GEMMINI_ORDER_JI ? "ji" : "ij",
+                 s->cfg.tile_i, s->cfg.tile_j, s->cfg.tile_k);
+    }
+}
+
+// Largest tile_k <= Kt that fits next to a tile_i x tile_j block (0 if none)
+static size_t gemmini_tune_max_tile_k(size_t ti, size_t tj, size_t Kt, size_t banks) {
+    gemmini_tile_cfg_t cfg = { ti, tj, Kt, GEMMINI_ORDER_IJ };
+    const size_t fit = GEMMINI_SP_ROWS / banks / ((ti + tj) * DIM);
+    cfg.tile_k = MIN(Kt, fit);
+    return gemmini_tile_cfg_fits(&cfg, banks) ? cfg.tile_k : 0;
+}
+
+// Block size after `t` tiles when stepping down from n: the largest power of
+// two below n, then halves (0 ends)
+static size_t gemmini_tune_next_tile(size_t t, size_t n) {
+    size_t p = 1;
+    if (t <= 1) return 0;
+    if (t < n) return t / 2;
+    while (p * 2 < n) p *= 2;
+    return p;
+}
+
+// Fill gemmini_tune_cands with every schedule of the search space that fits;
+// returns the number stored and counts the rest in *dropped
+static size_t gemmini_tune_enumerate(size_t M, size_t N, size_t K, size_t* dropped) {
+    const size_t I = CEIL_DIV(M, DIM), J = CEIL_DIV(N, DIM), Kt = CEIL_DIV(K, DIM);
+    // OS single, OS double, WS
+    static const struct { int dataflow; gemmini_sched_t sched; } variants[] = {
+        { OUTPUT_STATIONARY, GEMMINI_SCHED_SINGLE_BUFFER },
+        { OUTPUT_STATIONARY, GEMMINI_SCHED_DOUBLE_BUFFER },
+        { WEIGHT_STATIONARY, GEMMINI_SCHED_SINGLE_BUFFER },
+    };
+    size_t count = 0;
+    *dropped = 0;
+
+    for (size_t ti = I; ti > 0; ti = gemmini_tune_next_tile(ti, I)) {
+        for (size_t tj = J; tj > 0; tj = gemmini_tune_next_tile(tj, J)) {
+            for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+                gemmini_schedule_t s;
+                s.dataflow = variants[v].dataflow;
+                s.sched = variants[v].sched;
+                const size_t kmax =
+                    gemmini_tune_max_tile_k(ti, tj, Kt, gemmini_schedule_banks(&s));
+                // The order only matters with more than one block both ways
+                const int orders =
+                    (s.dataflow == OUTPUT_STATIONARY && ti < I && tj < J) ? 2 : 1;
+
+                for (size_t tk = kmax; tk > 0; tk = (tk > kmax / 4 && tk > 1) ? tk / 2 : 0) {
+                    for (int o = 0; o < orders; o++) {
+                        s.cfg.tile_i = ti;
+                        s.cfg.tile_j = tj;
+                        s.cfg.tile_k = tk;
+                        s.cfg.order = o ? GEMMINI_ORDER_JI : GEMMINI_ORDER_IJ;
+                        if (count < GEMMINI_TUNE_MAX_CANDIDATES) {
+                            gemmini_tune_cands[count].s = s;
+                            gemmini_tune_cands[count].cycles = 0;
+                            count++;
+                        } else {
+                            (*dropped)++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Tune C = A * B (packed INT8, M x K times K x N). `ref` is the expected C
+// for checking the finalists (NULL skips the check). Returns 0 when a
+// verified schedule was found; r->best is the default schedule otherwise.
+static int gemmini_tune(const elem_t* A, const elem_t* B, elem_t* C, const elem_t* ref,
+                        size_t M, size_t N, size_t K, gemmini_tune_result_t* r) {
+    memset(r, 0, sizeof(*r));
+    r->m = M;
+    r->n = N;
+    r->k = K;
+    r->best = gemmini_default_schedule(M, N, K);
+    r->candidates = gemmini_tune_enumerate(M, N, K, &r->dropped);
+
+    // Screening: one run each; a failed run sorts last
+    for (size_t c = 0; c < r->candidates; c++) {
+        gemmini_flush(0);
+        uint64_t start = read_csr_mcycle();
+        int rc = gemmini_tiled_matmul_schedule(A, B, C, M, N, K, &gemmini_tune_cands[c].s);
+        gemmini_tune_cands[c].cycles = rc ? UINT64_MAX : read_csr_mcycle() - start;
+    }
+
+    // Partial selection sort of the fastest finalists
+    r->num_finalists = MIN(GEMMINI_TUNE_FINALISTS, r->candidates);
+    for (size_t f = 0; f < r->num_finalists; f++) {
+        size_t best = f;
+        for (size_t c = f + 1; c < r->candidates; c++) {
+            if (gemmini_tune_cands[c].cycles < gemmini_tune_cands[best].cycles) best = c;
+        }
+        gemmini_tune_cand_t t = gemmini_tune_cands[f];
+        gemmini_tune_cands[f] = gemmini_tune_cands[best];
+        gemmini_tune_cands[best] = t;
+        r->finalists[f] = gemmini_tune_cands[f];
+    }
+
+    // Finalists: medians, and each output checked
+    int found = 0;
+    for (size_t f = 0; f < r->num_finalists; f++) {
+        const gemmini_schedule_t* s = &r->finalists[f].s;
+        bench_stats_t st;
+        int rc = 0;
+        BENCH_RUN(&st, gemmini_flush(0),
+                  rc |= gemmini_tiled_matmul_schedule(A, B, C, M, N, K, s));
+        int errors = rc != 0;
+        if (ref) errors += count_mismatches_int8(C, ref, M * N);
+        r->finalist_median[f] = errors ? 0 : st.median;
+        r->errors += errors;
+        if (!errors && (!found || st.median < r->best_st.median)) {
+            r->best = *s;
+            r->best_st = st;
+            found = 1;
+        }
+    }
+
+    if (found && gemmini_tune_logged < GEMMINI_TUNE_MAX_SHAPES) {
+        gemmini_tuned_t* e = &gemmini_tune_log[gemmini_tune_logged];
+        e->m = M;
+        e->n = N;
+        e->k = K;
+        e->dim = DIM;
+        e->s = r->best;
+        gemmini_tune_log_cycles[gemmini_tune_logged++] = r->best_st.median;
+    }
+    return found ? 0 : -1;
+}
+
+// Print every tuned shape as a GEMMINI_TUNED_TABLE file for this config
+static void gemmini_tune_dump(void) {
+    printf("#GEMMINI_TUNED_BEGIN\n");
+    printf("// Tuned on %s (DIM %d, %d scratchpad rows, %d accumulator rows)\n",
+           BENCH_CONFIG, DIM, (int)GEMMINI_SP_ROWS, (int)ACC_ROWS);
+    for (size_t i = 0; i < gemmini_tune_logged; i++) {
+        const gemmini_tuned_t* e = &gemmini_tune_log[i];
+        printf("GEMMINI_TUNED_ENTRY(%zu, %zu, %zu, %zu, %zu, %zu, %zu, %s, %s, %s)"
+               "  // %llu cycles\n",
+               e->m, e->n, e->k, e->dim, e->s.cfg.tile_i, e->s.cfg.tile_j, e->s.cfg.tile_k,
+               gemmini_order_name(e->s.cfg.order),
+               e->s.dataflow == WEIGHT_STATIONARY ? "WEIGHT_STATIONARY" : "OUTPUT_STATIONARY",
+               gemmini_sched_name(e->s.sched), (unsigned long long)gemmini_tune_log_cycles[i]);
+    }
+    printf("#GEMMINI_TUNED_END\n");
+}
+
+#endif // TUNE_MODE
+
+#endif // BENCH_TUNE_H
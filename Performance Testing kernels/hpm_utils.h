@@ -0,0 +1,238 @@
+// Hardware Performance Monitor (HPM) counter-set API for the benchmark kernels
+// Programs mhpmevent3..8 with a named event group and samples regions
+// See "Learn from Basics/HPMs_Master.md" for the Rocket event encodings
+//
+// The SoC must be built with chipyard.config.WithNPerfCounters(n), n >= 6.
+// Without it Rocket hardwires mhpmcounterN to zero and every delta reads 0.
+//
+// Linux builds (no -DBAREMETAL) run in U-mode, where the event selectors
+// and mcountinhibit cannot be written: they sample only cycle and instret
+// and report the "none" group.
+
+#ifndef HPM_UTILS_H
+#define HPM_UTILS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// ============================================================================
+// Event Encodings: (event mask << 8) | EventSet ID
+// ============================================================================
+
+// EventSet 0: Instruction types
+#define HPM_EVENT_LOAD          0x200ULL
+#define HPM_EVENT_STORE         0x400ULL
+#define HPM_EVENT_SYSTEM        0x1000ULL
+#define HPM_EVENT_ARITH         0x2000ULL
+#define HPM_EVENT_BRANCH        0x4000ULL
+#define HPM_EVENT_MUL           0x20000ULL
+
+// EventSet 1: Pipeline stalls
+#define HPM_EVENT_LOAD_USE      0x101ULL
+#define HPM_EVENT_LONG_LATENCY  0x201ULL
+#define HPM_EVENT_ICACHE_BLOCK  0x801ULL
+#define HPM_EVENT_DCACHE_BLOCK  0x1001ULL
+#define HPM_EVENT_BRANCH_MISS   0x2001ULL
+#define HPM_EVENT_REPLAY        0x10001ULL
+
+// EventSet 2: Cache/TLB
+#define HPM_EVENT_ICACHE_MISS   0x102ULL
+#define HPM_EVENT_DCACHE_MISS   0x202ULL
+#define HPM_EVENT_DCACHE_WB     0x402ULL
+#define HPM_EVENT_ITLB_MISS     0x802ULL
+#define HPM_EVENT_DTLB_MISS     0x1002ULL
+#define HPM_EVENT_L2TLB_MISS    0x2002ULL
+
+// ============================================================================
+// CSR Access
+// ============================================================================
+
+#define HPM_NUM_COUNTERS 6  // mhpmcounter3 .. mhpmcounter8
+
+// The CSR name is macro-expanded first, so HPM_CYCLE_CSR works as `csr`
+#define HPM_STR_(x) #x
+#define HPM_STR(x) HPM_STR_(x)
+
+#define HPM_READ_CSR(csr) ({ \
+    uint64_t __v; \
+    asm volatile("csrr %0, " HPM_STR(csr) : "=r"(__v)); \
+    __v; \
+})
+
+#define HPM_WRITE_CSR(csr, val) \
+    asm volatile("csrw " HPM_STR(csr) ", %0" : : "r"((uint64_t)(val)))
+
+// Cycle and instret as readable at the current privilege level
+#ifdef BAREMETAL
+#define HPM_CYCLE_CSR   mcycle
+#define HPM_INSTRET_CSR minstret
+#else
+#define HPM_CYCLE_CSR   cycle
+#define HPM_INSTRET_CSR instret
+#endif
+
+static inline void hpm_write_event(size_t idx, uint64_t event) {
+    switch (idx) {
+        case 0: HPM_WRITE_CSR(mhpmevent3, event); HPM_WRITE_CSR(mhpmcounter3, 0); break;
+        case 1: HPM_WRITE_CSR(mhpmevent4, event); HPM_WRITE_CSR(mhpmcounter4, 0); break;
+        case 2: HPM_WRITE_CSR(mhpmevent5, event); HPM_WRITE_CSR(mhpmcounter5, 0); break;
+        case 3: HPM_WRITE_CSR(mhpmevent6, event); HPM_WRITE_CSR(mhpmcounter6, 0); break;
+        case 4: HPM_WRITE_CSR(mhpmevent7, event); HPM_WRITE_CSR(mhpmcounter7, 0); break;
+        case 5: HPM_WRITE_CSR(mhpmevent8, event); HPM_WRITE_CSR(mhpmcounter8, 0); break;
+        default: break;
+    }
+}
+
+static inline uint64_t hpm_read_counter(size_t idx) {
+    switch (idx) {
+        case 0: return HPM_READ_CSR(mhpmcounter3);
+        case 1: return HPM_READ_CSR(mhpmcounter4);
+        case 2: return HPM_READ_CSR(mhpmcounter5);
+        case 3: return HPM_READ_CSR(mhpmcounter6);
+        case 4: return HPM_READ_CSR(mhpmcounter7);
+        case 5: return HPM_READ_CSR(mhpmcounter8);
+        default: return 0;
+    }
+}
+
+// ============================================================================
+// Event Groups
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    size_t num_events;
+    uint64_t events[HPM_NUM_COUNTERS];
+    const char* labels[HPM_NUM_COUNTERS];  // Human-readable, for [PERF] blocks
+    const char* keys[HPM_NUM_COUNTERS];    // Stable identifiers, for CSV/JSON
+} hpm_group_t;
+
+// Memory-bound vs. issue-bound at a glance (default for [PERF] blocks)
+static const hpm_group_t hpm_group_cache_stall = {
+    "cache+stall", 6,
+    { HPM_EVENT_DCACHE_MISS, HPM_EVENT_DCACHE_BLOCK, HPM_EVENT_DTLB_MISS,
+      HPM_EVENT_ICACHE_MISS, HPM_EVENT_LOAD_USE, HPM_EVENT_BRANCH_MISS },
+    { "D$ misses", "D$ blocked", "DTLB misses",
+      "I$ misses", "Load-use stalls", "Branch mispredicts" },
+    { "dcache_miss", "dcache_blocked", "dtlb_miss",
+      "icache_miss", "load_use", "branch_miss" },
+};
+
+// Cache and TLB traffic only
+static const hpm_group_t hpm_group_memory = {
+    "memory", 6,
+    { HPM_EVENT_DCACHE_MISS, HPM_EVENT_DCACHE_WB, HPM_EVENT_DTLB_MISS,
+      HPM_EVENT_L2TLB_MISS, HPM_EVENT_ICACHE_MISS, HPM_EVENT_ITLB_MISS },
+    { "D$ misses", "D$ writebacks", "DTLB misses",
+      "L2 TLB misses", "I$ misses", "ITLB misses" },
+    { "dcache_miss", "dcache_wb", "dtlb_miss",
+      "l2tlb_miss", "icache_miss", "itlb_miss" },
+};
+
+// Pipeline interlocks and flushes
+static const hpm_group_t hpm_group_pipeline = {
+    "pipeline", 6,
+    { HPM_EVENT_LOAD_USE, HPM_EVENT_LONG_LATENCY, HPM_EVENT_ICACHE_BLOCK,
+      HPM_EVENT_DCACHE_BLOCK, HPM_EVENT_BRANCH_MISS, HPM_EVENT_REPLAY },
+    { "Load-use stalls", "Long-latency stalls", "I$ blocked",
+      "D$ blocked", "Branch mispredicts", "Replays" },
+    { "load_use", "long_latency", "icache_blocked",
+      "dcache_blocked", "branch_miss", "replay" },
+};
+
+// Retired instruction mix
+static const hpm_group_t hpm_group_mix = {
+    "mix", 6,
+    { HPM_EVENT_LOAD, HPM_EVENT_STORE, HPM_EVENT_ARITH,
+      HPM_EVENT_BRANCH, HPM_EVENT_MUL, HPM_EVENT_SYSTEM },
+    { "Loads", "Stores", "Arith", "Branches", "Muls", "System" },
+    { "load", "store", "arith", "branch", "mul", "system" },
+};
+
+// No event counters: cycles and instret only
+static const hpm_group_t hpm_group_none = { "none", 0, { 0 }, { NULL }, { NULL } };
+
+// Group used by the [PERF] blocks; override with -DHPM_GROUP=hpm_group_memory
+// (ignored under Linux, which is always hpm_group_none)
+#ifndef BAREMETAL
+#undef HPM_GROUP
+#define HPM_GROUP hpm_group_none
+#endif
+#ifndef HPM_GROUP
+#define HPM_GROUP hpm_group_cache_stall
+#endif
+
+// ============================================================================
+// Region Sampling
+// ============================================================================
+
+typedef struct {
+    uint64_t cycles;
+    uint64_t instret;
+    uint64_t counters[HPM_NUM_COUNTERS];
+} hpm_sample_t;
+
+typedef struct {
+    const hpm_group_t* group;
+    hpm_sample_t start;
+    hpm_sample_t delta;
+} hpm_region_t;
+
+static const hpm_group_t* hpm_active_group = NULL;
+
+// Enable all counters and program the event selectors for a group.
+// Reprogramming is skipped when the group is already active.
+// Under Linux nothing is programmed and every group samples as "none".
+static inline void hpm_configure(const hpm_group_t* group) {
+    if (hpm_active_group == group) return;
+#ifdef BAREMETAL
+    HPM_WRITE_CSR(mcountinhibit, 0);
+    for (size_t i = 0; i < HPM_NUM_COUNTERS; i++) {
+        hpm_write_event(i, i < group->num_events ? group->events[i] : 0);
+    }
+#endif
+    hpm_active_group = group;
+}
+
+// Event counters are read first and mcycle last so the CSR reads
+// themselves fall outside the measured cycle window as far as possible.
+static inline void hpm_start(hpm_region_t* r, const hpm_group_t* group) {
+#ifndef BAREMETAL
+    group = &hpm_group_none;
+#endif
+    hpm_configure(group);
+    r->group = group;
+    for (size_t i = 0; i < group->num_events; i++) {
+        r->start.counters[i] = hpm_read_counter(i);
+    }
+    r->start.instret = HPM_READ_CSR(HPM_INSTRET_CSR);
+    r->start.cycles = HPM_READ_CSR(HPM_CYCLE_CSR);
+}
+
+static inline void hpm_stop(hpm_region_t* r) {
+    uint64_t cycles = HPM_READ_CSR(HPM_CYCLE_CSR);
+    uint64_t instret = HPM_READ_CSR(HPM_INSTRET_CSR);
+    r->delta.cycles = cycles - r->start.cycles;
+    r->delta.instret = instret - r->start.instret;
+    for (size_t i = 0; i < r->group->num_events; i++) {
+        r->delta.counters[i] = hpm_read_counter(i) - r->start.counters[i];
+    }
+}
+
+// Print "  Instructions/<event>: N" lines for a [PERF] block
+static void hpm_print_counters(const hpm_region_t* r) {
+    printf("  Instructions: %llu\n", (unsigned long long)r->delta.instret);
+    for (size_t i = 0; i < r->group->num_events; i++) {
+        printf("  %s: %llu\n", r->group->labels[i],
+               (unsigned long long)r->delta.counters[i]);
+    }
+}
+
+// Same, preceded by the region's cycle count
+static void hpm_print_region(const hpm_region_t* r) {
+    printf("  Cycles: %llu\n", (unsigned long long)r->delta.cycles);
+    hpm_print_counters(r);
+}
+
+#endif // HPM_UTILS_H